@@ -1,20 +1,40 @@
 #pragma once
 
-#include <OneButton.h>
+#include <Arduino.h>
 
-#include <thread>
+#include <array>
+#include <cstdint>
 
 #include "glut_platform.hh"
 #include "ssdui/context/component.hh"
 #include "ssdui/context/context.hh"
+#include "ssdui/input/manager.hh"
+
 class GlutEventScanner : SSDUI::Context::BaseComponent<GlutPlatform> {
  private:
-  OneButton key_up_{8, true, true};
-  OneButton key_down_{12, true, true};
-  OneButton key_left_{3, true, true};
-  OneButton key_right_{7, true, true};
-
-  std::thread button_thread_;
+  using InputManager = SSDUI::Input::InputManager<GlutPlatform, 4>;
+
+  struct Key {
+    InputManager* manager;
+    std::uint8_t pin;
+    std::uint8_t channel;
+    GlutEvent event;
+  };
+
+  InputManager input_{};
+
+  std::array<Key, 4> keys_{{
+      {&input_, 8, 0, GlutEvent::KeyUp},
+      {&input_, 12, 1, GlutEvent::KeyDown},
+      {&input_, 3, 2, GlutEvent::KeyLeft},
+      {&input_, 7, 3, GlutEvent::KeyRight},
+  }};
+
+  // 按键低电平有效，中断中只记录电平与时刻
+  static void ARDUINO_ISR_ATTR _on_change(void* data) {
+    auto* key = static_cast<Key*>(data);
+    key->manager->push(key->channel, digitalRead(key->pin) == LOW);
+  }
 
  public:
   GlutEventScanner() {
@@ -22,52 +42,16 @@ class GlutEventScanner : SSDUI::Context::BaseComponent<GlutPlatform> {
     gpio_set_level(GPIO_NUM_12, HIGH);
   }
 
-  ~GlutEventScanner() {
-    if (button_thread_.joinable()) {
-      button_thread_.join();
-    }
-  }
-
   void on_mount(SSDUI::Context::Context<GlutPlatform>* context) override {
-    auto& emgr = context->event_manager();
-    key_up_.attachClick(
-        [](void* emgr) {
-          auto* em =
-              static_cast<SSDUI::Context::EventManager<GlutPlatform>*>(emgr);
-          em->trigger_event(GlutEvent::KeyUp);
-        },
-        (void*)(&emgr));
-    key_down_.attachClick(
-        [](void* emgr) {
-          auto* em =
-              static_cast<SSDUI::Context::EventManager<GlutPlatform>*>(emgr);
-          em->trigger_event(GlutEvent::KeyDown);
-        },
-        (void*)(&emgr));
-    key_left_.attachClick(
-        [](void* emgr) {
-          auto* em =
-              static_cast<SSDUI::Context::EventManager<GlutPlatform>*>(emgr);
-          em->trigger_event(GlutEvent::KeyLeft);
-        },
-        (void*)(&emgr));
-    key_right_.attachClick(
-        [](void* emgr) {
-          auto* em =
-              static_cast<SSDUI::Context::EventManager<GlutPlatform>*>(emgr);
-          em->trigger_event(GlutEvent::KeyRight);
-        },
-        (void*)(&emgr));
-
-    button_thread_ = std::thread([this]() {
-      while (true) {
-        key_up_.tick();
-        key_down_.tick();
-        key_left_.tick();
-        key_right_.tick();
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    for (auto& key : keys_) {
+      input_.bind(key.channel, SSDUI::Input::Gesture::Click, key.event);
+      if (key.pin != 12) {
+        pinMode(key.pin, INPUT_PULLUP);
       }
-    });
+      attachInterruptArg(key.pin, &GlutEventScanner::_on_change, &key, CHANGE);
+    }
+
+    input_.attach(context);
   }
 
   void operator()(SSDUI::Context::Context<GlutPlatform>* context) {}
@@ -6,8 +6,9 @@
 
 #include "glut_platform.hh"
 #include "ssdui/components/geometry.hh"
+#include "ssdui/context/node.hh"
 
-class GlutFood : public SSDUI::Context::BaseComponent<GlutPlatform> {
+class GlutFood : public SSDUI::Context::Node<GlutPlatform> {
  public:
   static constexpr std::int32_t WIDTH = 4;
 
@@ -16,13 +17,23 @@ class GlutFood : public SSDUI::Context::BaseComponent<GlutPlatform> {
   std::mt19937 gen_{rd_()};
   // SSDUI::Geometry::Point<std::int32_t> position_{_generate_position()};
 
+  SSDUI::Context::Context<GlutPlatform>* context_{nullptr};
+
   SSDUI::Geometry::Point<std::int32_t> _generate_position() {
     return {static_cast<int>(gen_() % 32) * 4,
             static_cast<int>(gen_() % 16) * 4};
   }
 
+  /**
+   * @brief 事件回调不在渲染线程，包围盒推迟到帧回调中移动到新的食物位置
+   */
+  static void _follow_food(void* data) {
+    auto* self = static_cast<GlutFood*>(data);
+    self->set_bounds({self->context_->store().food, {WIDTH, WIDTH}});
+  }
+
  public:
-  GlutFood() = default;
+  GlutFood() : Node({{0, 0}, {WIDTH, WIDTH}}) {}
   virtual ~GlutFood() = default;
 
   GlutFood(const GlutFood&) = delete;
@@ -31,20 +42,24 @@ class GlutFood : public SSDUI::Context::BaseComponent<GlutPlatform> {
   GlutFood& operator=(GlutFood&&) = delete;
 
   void on_mount(SSDUI::Context::Context<GlutPlatform>* context) override {
+    context_ = context;
     context->event_manager().register_event(
         GlutEvent::FoodEaten, [this](auto* ctx) {
           ctx->store().food = _generate_position();
           ctx->store().score += 1;
+          ctx->on_next_frame(&GlutFood::_follow_food, this);
         });
     context->event_manager().register_event(
-        GlutEvent::GameStart,
-        [this](auto* ctx) { ctx->store().food = _generate_position(); });
+        GlutEvent::GameStart, [this](auto* ctx) {
+          ctx->store().food = _generate_position();
+          ctx->on_next_frame(&GlutFood::_follow_food, this);
+        });
   }
 
-  void operator()(SSDUI::Context::Context<GlutPlatform>* context) override {
+  void draw(SSDUI::Context::Context<GlutPlatform>* context) override {
+    // 画在包围盒处，食物位置变化后，到包围盒移动的那一帧才画在新位置
     if (context->store().state == GlutState::Running) {
-      SSDUI::Components::Rectangle<GlutPlatform>{
-          {context->store().food, {WIDTH, WIDTH}}}(context);
+      SSDUI::Components::Rectangle<GlutPlatform>{bounds()}(context);
     }
   }
 };
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <ssd1306.hh>
+#include <ssdui/components/group.hh>
+#include <ssdui/components/label.hh>
 #include <ssdui/context/component.hh>
+#include <ssdui/context/node.hh>
 
 #include "glut_event.hh"
 #include "glut_food.hh"
@@ -11,14 +14,38 @@
 #include "glut_string.hh"
 #include "ssdui/context/context.hh"
 
-class GlutRoot : public SSDUI::Context::BaseComponent<GlutPlatform> {
+// 根节点覆盖整个屏幕，游戏状态变化时整屏重绘
+class GlutRoot : public SSDUI::Context::Node<GlutPlatform> {
  private:
-  GlutEventScanner event_scanner_{};
-  GlutSnake snake_{};
-  GlutFood food_{};
+  SSDUI::Components::Group<GlutPlatform, GlutEventScanner, GlutSnake,
+                           GlutFood>
+      children_{};
+
+  // 分数只在游戏结束时显示，数字部分增量更新，不再构造字符串
+  SSDUI::Components::Label<GlutPlatform, 6> score_{glut_font,
+                                                   {{86, 24}, {42, 16}}};
+
+  SSDUI::Context::Context<GlutPlatform>* context_{nullptr};
+
+  // 标签在渲染线程读取，事件回调中只登记帧回调，在帧回调中按游戏状态更新
+  static void _sync_score(void* data) {
+    auto* self = static_cast<GlutRoot*>(data);
+    if (self->context_->store().state == GlutState::Failed) {
+      self->score_.set(self->context_->store().score);
+    } else {
+      self->score_.clear();
+    }
+  }
 
  public:
-  GlutRoot() = default;
+  GlutRoot() : Node({{0, 0}, {128, 64}}) {
+    // 根节点的画面只取决于游戏状态，状态变化时都会 invalidate，可以缓存
+    set_cache(SSDUI::Context::Cache::List);
+    // 子组件由 Group 持有，蛇与食物同时挂到保留树上参与局部重绘
+    add_child(&children_.get<1>());
+    add_child(&children_.get<2>());
+    add_child(&score_);
+  }
   virtual ~GlutRoot() = default;
 
   GlutRoot(const GlutRoot&) = delete;
@@ -27,16 +54,23 @@ class GlutRoot : public SSDUI::Context::BaseComponent<GlutPlatform> {
   GlutRoot& operator=(GlutRoot&&) = delete;
 
   void on_mount(SSDUI::Context::Context<GlutPlatform>* context) override {
+    context_ = context;
+
     // 触发游戏结束事件，同步全局状态
     context->event_manager().register_event(
-        GlutEvent::GameOver,
-        [this](auto* ctx) { ctx->store().state = GlutState::Failed; });
+        GlutEvent::GameOver, [this](auto* ctx) {
+          ctx->store().state = GlutState::Failed;
+          ctx->on_next_frame(&GlutRoot::_sync_score, this);
+          invalidate();
+        });
 
     // 触发游戏开始事件，同步全局状态
     context->event_manager().register_event(
         GlutEvent::GameStart, [this](auto* ctx) {
           ctx->store().state = GlutState::Running;
           ctx->store().score = 0;
+          ctx->on_next_frame(&GlutRoot::_sync_score, this);
+          invalidate();
         });
 
     // 在game over或预备状态下，按任意键重新开始游戏
@@ -69,24 +103,18 @@ class GlutRoot : public SSDUI::Context::BaseComponent<GlutPlatform> {
           }
         });
 
-    event_scanner_.on_mount(context);
-    snake_.on_mount(context);
-    food_.on_mount(context);
+    children_.on_mount(context);
+    score_.on_mount(context);
   }
 
-  void operator()(SSDUI::Context::Context<GlutPlatform>* context) override {
-    auto score = context->store().score;
-
+  void draw(SSDUI::Context::Context<GlutPlatform>* context) override {
     if (context->store().state == GlutState::Ready) {
       GlutString{"GluttonousSnake", {4, 12}}(context);
       GlutString{"Press any key", {12, 32}}(context);
     } else if (context->store().state == GlutState::Failed) {
       GlutString{"Game Over", {28, 8}}(context);
-      GlutString{"Score: " + std::to_string(score), {30, 24}}(context);
+      GlutString{"Score:", {30, 24}}(context);
       GlutString{"Press any key", {12, 40}}(context);
     }
-
-    snake_(context);
-    food_(context);
   }
 };
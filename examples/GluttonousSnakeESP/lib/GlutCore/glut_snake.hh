@@ -1,8 +1,7 @@
 #pragma once
 
-#include <condition_variable>
+#include <chrono>
 #include <cstdint>
-#include <thread>
 #include <vector>
 
 #include "HardwareSerial.h"
@@ -10,11 +9,15 @@
 #include "glut_platform.hh"
 #include "ssdui/components/geometry.hh"
 #include "ssdui/context/context.hh"
+#if defined(__cpp_impl_coroutine)
+#include "ssdui/context/task.hh"
+#endif
 #include "ssdui/geometry/point.hh"
 
 enum class GlutSnakeDirection { Up, Down, Left, Right };
 
-class GlutSnake : public SSDUI::Context::BaseComponent<GlutPlatform> {
+// 蛇的包围盒为整个屏幕，每一步只报告头尾两格的变化
+class GlutSnake : public SSDUI::Context::Node<GlutPlatform> {
  public:
   static constexpr int32_t SNACK_SIZE = 4;
 
@@ -22,64 +25,90 @@ class GlutSnake : public SSDUI::Context::BaseComponent<GlutPlatform> {
   std::vector<SSDUI::Geometry::Point<int32_t>> snake{{64, 32}};
   GlutSnakeDirection direction_{GlutSnakeDirection::Right};
 
-  std::thread move_thread_;
+  static constexpr auto MOVE_PERIOD = std::chrono::milliseconds(100);
 
-  void _move_handler(SSDUI::Context::Context<GlutPlatform>* context) {
-    while (true) {
-      if (context->store().state != GlutState::Running) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        continue;
-      }
+#if defined(__cpp_impl_coroutine)
+  SSDUI::Context::Task move_task_{};
+#endif
 
-      auto head = snake.front();
-      snake.pop_back();
-
-      switch (direction_) {
-        case GlutSnakeDirection::Up:
-          head.y -= SNACK_SIZE;
-          // head.y = head.y < 0 ? 60 : head.y;
-          break;
-        case GlutSnakeDirection::Down:
-          head.y += SNACK_SIZE;
-          // head.y = head.y > 64 ? 0 : head.y;
-          break;
-        case GlutSnakeDirection::Left:
-          head.x -= SNACK_SIZE;
-          // head.x = head.x < 0 ? 124 : head.x;
-          break;
-        case GlutSnakeDirection::Right:
-          head.x += SNACK_SIZE;
-          // head.x = head.x > 128 ? 0 : head.x;
-          break;
-      }
+  void _move(SSDUI::Context::Context<GlutPlatform>* context) {
+    if (context->store().state != GlutState::Running) {
+      return;
+    }
 
-      // overflow check
-      head.x = head.x < 0 ? 124 : head.x;
-      head.x = head.x > 124 ? 0 : head.x;
-      head.y = head.y < 0 ? 60 : head.y;
-      head.y = head.y > 60 ? 0 : head.y;
+    auto head = snake.front();
+    auto tail = snake.back();
+    snake.pop_back();
+
+    switch (direction_) {
+      case GlutSnakeDirection::Up:
+        head.y -= SNACK_SIZE;
+        // head.y = head.y < 0 ? 60 : head.y;
+        break;
+      case GlutSnakeDirection::Down:
+        head.y += SNACK_SIZE;
+        // head.y = head.y > 64 ? 0 : head.y;
+        break;
+      case GlutSnakeDirection::Left:
+        head.x -= SNACK_SIZE;
+        // head.x = head.x < 0 ? 124 : head.x;
+        break;
+      case GlutSnakeDirection::Right:
+        head.x += SNACK_SIZE;
+        // head.x = head.x > 128 ? 0 : head.x;
+        break;
+    }
 
-      snake.insert(snake.begin(), head);
+    // overflow check
+    head.x = head.x < 0 ? 124 : head.x;
+    head.x = head.x > 124 ? 0 : head.x;
+    head.y = head.y < 0 ? 60 : head.y;
+    head.y = head.y > 60 ? 0 : head.y;
 
-      // if snake hit itself, trigger GameOver
-      for (size_t i = 1; i < snake.size(); ++i) {
-        if (head.x == snake[i].x && head.y == snake[i].y) {
-          context->event_manager().trigger_event(GlutEvent::GameOver);
-          break;
-        }
-      }
+    snake.insert(snake.begin(), head);
 
-      // if snake get food, trigger FoodEaten
-      auto [food_x, food_y] = context->store().food;
-      if (head.x == food_x && head.y == food_y) {
-        context->event_manager().trigger_event(GlutEvent::FoodEaten);
-        // snake.push_back(snake.back());
+    context->invalidate({tail, {SNACK_SIZE, SNACK_SIZE}});
+    context->invalidate({head, {SNACK_SIZE, SNACK_SIZE}});
+
+    // if snake hit itself, trigger GameOver
+    for (size_t i = 1; i < snake.size(); ++i) {
+      if (head.x == snake[i].x && head.y == snake[i].y) {
+        context->event_manager().trigger_event(GlutEvent::GameOver);
+        break;
       }
+    }
 
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // if snake get food, trigger FoodEaten
+    auto [food_x, food_y] = context->store().food;
+    if (head.x == food_x && head.y == food_y) {
+      context->event_manager().trigger_event(GlutEvent::FoodEaten);
+      // snake.push_back(snake.back());
     }
   }
 
+#if defined(__cpp_impl_coroutine)
+  SSDUI::Context::Task _move_loop(
+      SSDUI::Context::Context<GlutPlatform>* context) {
+    while (true) {
+      _move(context);
+      co_await context->sleep_for(MOVE_PERIOD);
+    }
+  }
+#endif
+
+  // 默认环境不启用协程，或协程帧内存池耗尽时，使用周期定时器
+  void _start_moving(SSDUI::Context::Context<GlutPlatform>* context) {
+#if defined(__cpp_impl_coroutine)
+    move_task_ = _move_loop(context);
+    if (move_task_.valid()) {
+      move_task_.start();
+      return;
+    }
+#endif
+    context->scheduler().schedule_periodic(
+        MOVE_PERIOD, [this](auto* ctx) { _move(ctx); });
+  }
+
   void _reset() {
     snake.clear();
     snake.emplace_back(64, 32);
@@ -87,12 +116,7 @@ class GlutSnake : public SSDUI::Context::BaseComponent<GlutPlatform> {
   }
 
  public:
-  GlutSnake() = default;
-  ~GlutSnake() {
-    if (move_thread_.joinable()) {
-      move_thread_.join();
-    }
-  }
+  GlutSnake() : Node({{0, 0}, {128, 64}}) {}
 
   void on_mount(SSDUI::Context::Context<GlutPlatform>* context) override {
     context->event_manager().register_event(GlutEvent::KeyUp, [this](auto) {
@@ -120,10 +144,10 @@ class GlutSnake : public SSDUI::Context::BaseComponent<GlutPlatform> {
     context->event_manager().register_event(GlutEvent::GameStart,
                                             [this](auto) { _reset(); });
 
-    move_thread_ = std::thread(&GlutSnake::_move_handler, this, context);
+    _start_moving(context);
   }
 
-  void operator()(SSDUI::Context::Context<GlutPlatform>* context) override {
+  void draw(SSDUI::Context::Context<GlutPlatform>* context) override {
     if (context->store().state == GlutState::Running) {
       for (const auto& point : snake) {
         SSDUI::Components::Rectangle<GlutPlatform>{
@@ -7,13 +7,15 @@
 // #include <ssdui/context/context.hh>
 
 #include "glut_platform.hh"
-#include "ssdui/components/geometry.hh"
+#include "ssdui/components/text.hh"
 #include "ssdui/context/context.hh"
 #include "ssdui/geometry/point.hh"
+#include "ssdui/graphics/font.hh"
+#include "ssdui/graphics/font_compiler.hh"
 
 // From :
 // https://github.com/libdriver/ssd1306/blob/master/src/driver_ssd1306_font.hcccccccccc
-const uint8_t ssd1306xled_font8x16[] = {
+inline constexpr uint8_t ssd1306xled_font8x16[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  //   0
     0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00,
@@ -206,6 +208,18 @@ const uint8_t ssd1306xled_font8x16[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // ~ 94
 };
 
+// 只保留游戏中用到的字符，保持等宽以免改变现有布局
+// ESP32 的工具链早于 GCC 12，不能使用 compile_font，改用函数参数形式
+inline constexpr std::string_view glut_font_charset =
+    "GluttonousSnakePressanykeyGameOverScore:0123456789";
+inline constexpr SSDUI::Graphics::MonoSource glut_font_source{
+    ssd1306xled_font8x16, 8, 2, ' ', '~'};
+inline constexpr auto glut_font_storage = SSDUI::Graphics::build_font<
+    SSDUI::Graphics::font_glyphs(glut_font_charset, glut_font_source),
+    SSDUI::Graphics::font_bytes(glut_font_charset, glut_font_source)>(
+    glut_font_charset, glut_font_source);
+inline constexpr SSDUI::Graphics::Font glut_font = glut_font_storage.font();
+
 class GlutChar : public SSDUI::Context::BaseComponent<GlutPlatform> {
  private:
   char c;
@@ -216,46 +230,20 @@ class GlutChar : public SSDUI::Context::BaseComponent<GlutPlatform> {
       : c(c), position(position) {}
 
   void operator()(SSDUI::Context::Context<GlutPlatform>* ctx) override {
-    auto index_start = c - 32;
-    auto font = &ssd1306xled_font8x16[index_start * 16];
-    // for (int x = 0; x < 8; x++) {
-    //   for (int y = 0; y < 16; y++) {
-    //     // 字体每一字节代表竖直方向的8个像素，先从左往右，后从上往下
-    //     if (font[x] & (1 << y)) {
-    //       SSDUI::Components::Point<GlutPlatform> point(
-    //           {position.x + x, position.y + y});
-    //       point(ctx);
-    //     }
-    //   }
-    // }
-    for (int y = 0; y < 16; y++) {
-      auto y_pos = y % 8;
-      for (int x = 0; x < 8; x++) {
-        auto index = (y > 7) ? (x + 8) : x;
-        if (font[index] & (1 << y_pos)) {
-          SSDUI::Components::Point<GlutPlatform> point(
-              {position.x + x, position.y + y});
-          point(ctx);
-        }
-      }
-    }
+    SSDUI::Components::Text<GlutPlatform>{glut_font, {&c, 1}, position}(ctx);
   }
 };
 
 class GlutString : public SSDUI::Context::BaseComponent<GlutPlatform> {
  public:
-  GlutString(const std::string& str, SSDUI::Geometry::Point<int32_t> position)
+  GlutString(std::string_view str, SSDUI::Geometry::Point<int32_t> position)
       : str(str), position(position) {}
 
   void operator()(SSDUI::Context::Context<GlutPlatform>* ctx) override {
-    auto x = position.x;
-    for (auto c : str) {
-      GlutChar(c, {x, position.y})(ctx);
-      x += 8;
-    }
+    SSDUI::Components::Text<GlutPlatform>{glut_font, str, position}(ctx);
   }
 
  private:
-  std::string str;
+  std::string_view str;
   SSDUI::Geometry::Point<int32_t> position;
 };
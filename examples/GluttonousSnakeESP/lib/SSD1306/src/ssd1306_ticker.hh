@@ -6,7 +6,6 @@
 #include <ssdui/geometry/rectangle.hh>
 #include <ssdui/platform/concepts.hh>
 #include <thread>
-#include <vector>
 
 #include "ssd1306.hh"
 #include "ssd1306_command.hh"
@@ -31,8 +30,12 @@ class Ticker {
     while (true) {
       auto start = std::chrono::high_resolution_clock::now();
 
-      context_->root()->operator()(context_.get());
-      auto dirty_regions = _get_dirty_rectangles(context_->buffer());
+      // 调度器未启用工作线程时，由帧计时器驱动
+      if (!context_->scheduler().enabled()) {
+        context_->scheduler().advance(context_.get());
+      }
+
+      auto dirty_regions = context_->render();
 
       for (const auto& region : dirty_regions) {
         auto sequence = context_->buffer().next().subspan(
@@ -46,9 +49,9 @@ class Ticker {
 
         context_->renderer()->data(sequence);
       }
+      context_->tracer().frame_flushed(!dirty_regions.empty());
 
-      context_->buffer().swap();
-      context_->buffer().clear();
+      context_->present();
 
       auto end = std::chrono::high_resolution_clock::now();
 
@@ -61,30 +64,6 @@ class Ticker {
     }
   }
 
-  std::vector<SSDUI::Geometry::Rectangle<int32_t>> _get_dirty_rectangles(
-      const SSDUI::Context::Buffer& buffer) {
-    std::vector<SSDUI::Geometry::Rectangle<int32_t>> dirty_regions{};
-    auto previous = buffer.prev();
-    auto next = buffer.next();
-    auto width = buffer.width();
-    auto height = buffer.height();
-
-    for (int32_t y = 0; y < height; y++) {
-      for (int32_t x = 0; x < width; x++) {
-        if (next[x + y * width] != previous[x + y * width]) {
-          int32_t start = x;
-          while (x < width && next[x + y * width] != previous[x + y * width]) {
-            x++;
-          }
-          dirty_regions.emplace_back(
-              SSDUI::Geometry::Rectangle<int32_t>{{start, y}, {x - start, 1}});
-        }
-      }
-    }
-
-    return dirty_regions;
-  }
-
  public:
   explicit Ticker(std::unique_ptr<SSDUIContext> context)
       : context_(std::move(context)), ticker_thread_([this] { _ticker(); }) {}
@@ -33,6 +33,7 @@ void setup() {
   auto context = std::move(opt.value());
 
   context->enable_event_manager();
+  context->enable_scheduler();
 
   SSD1306::Initializer<GlutPlatform>()(context.get());
 
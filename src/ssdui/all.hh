@@ -3,4 +3,6 @@
 #include "ssdui/components.hh"
 #include "ssdui/context.hh"
 #include "ssdui/geometry.hh"
+#include "ssdui/graphics.hh"
+#include "ssdui/input.hh"
 #include "ssdui/platform.hh"
\ No newline at end of file
@@ -1,3 +1,10 @@
 #pragma once
 
-#include "ssdui/components/geometry.hh"
\ No newline at end of file
+#include "ssdui/components/animation.hh"
+#include "ssdui/components/dithered_image.hh"
+#include "ssdui/components/geometry.hh"
+#include "ssdui/components/group.hh"
+#include "ssdui/components/image.hh"
+#include "ssdui/components/label.hh"
+#include "ssdui/components/sprite.hh"
+#include "ssdui/components/text.hh"
\ No newline at end of file
@@ -0,0 +1,244 @@
+#pragma once
+
+/**
+ *  增量动画
+ *
+ *  每帧只保存与上一帧不同的字节段（tools/packanim.py 生成），
+ *  切换帧时把这些字节写入当前画面，并按页把变化的列范围报告为损坏区域
+ *  （Context::invalidate）。没有变化的部分既不重绘也不发送，
+ *  每帧的开销只取决于实际变化的像素。
+ *
+ *  当前画面保存在节点中（width * pages 字节），与损坏区域相交时直接复制，
+ *  不需要重新解码。适用于开机动画、加载指示等循环播放的动画。
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ssdui/context/node.hh"
+#include "ssdui/geometry/point.hh"
+#include "ssdui/geometry/rectangle.hh"
+#include "ssdui/graphics/bitmap.hh"
+
+namespace SSDUI::Components {
+
+template <typename Pl>
+class Animation : public SSDUI::Context::Node<Pl> {
+ public:
+  using Rect = Geometry::Rectangle<std::int32_t>;
+
+ private:
+  Graphics::DeltaAnimation animation_;
+  std::vector<std::uint8_t> frame_;
+
+  /**
+   * @brief 当前帧的序号，以及下一条增量记录的位置
+   */
+  std::uint16_t index_{0};
+  std::uint32_t cursor_{0};
+
+  /**
+   * @brief 第 1 条记录的位置，循环回到第 0 帧后从这里继续
+   */
+  std::uint32_t first_delta_{0};
+
+  /**
+   * @brief 每隔 interval_ 帧切换一次，0 表示暂停
+   *        play/stop 可以在事件线程调用，这几个成员用原子变量；
+   *        elapsed_ 只在帧回调中读写，play 通过 restart_ 请求清零
+   */
+  std::atomic<std::uint32_t> interval_{0};
+  std::atomic<bool> loop_{true};
+  std::atomic<bool> restart_{false};
+  std::uint32_t elapsed_{0};
+
+  SSDUI::Context::Context<Pl>* context_{nullptr};
+
+  [[nodiscard]] std::uint32_t _u16(std::uint32_t at) const {
+    return animation_.data[at] |
+           static_cast<std::uint32_t>(animation_.data[at + 1]) << 8;
+  }
+
+  /**
+   * @brief 应用 cursor 处的一条记录，并报告变化的区域
+   *
+   * @return std::uint32_t 下一条记录的位置，数据损坏时停在出错处
+   */
+  std::uint32_t _apply(std::uint32_t cursor, bool report) {
+    const auto& bounds = this->bounds();
+    auto width = animation_.width;
+    auto size = animation_.size;
+    auto total = static_cast<std::uint32_t>(frame_.size());
+
+    // 每页变化的列范围 [x0, x1)，翻页或记录结束时报告
+    std::int32_t page = -1;
+    std::int32_t x0 = 0;
+    std::int32_t x1 = 0;
+    auto flush = [&]() {
+      if (report && page >= 0 && x0 < x1) {
+        _damage({{bounds.origin.x + x0, bounds.origin.y + page * 8},
+                 {x1 - x0, 8}});
+      }
+    };
+
+    if (cursor + 2 > size) {
+      return cursor;
+    }
+    auto runs = _u16(cursor);
+    cursor += 2;
+    for (std::uint32_t i = 0; i < runs; i++) {
+      if (cursor + 3 > size) {
+        break;
+      }
+      auto offset = _u16(cursor);
+      std::uint32_t length = animation_.data[cursor + 2];
+      cursor += 3;
+      if (cursor + length > size || offset + length > total) {
+        cursor = size;
+        break;
+      }
+      const auto* bytes = animation_.data + cursor;
+      cursor += length;
+
+      // 跨页的段按页拆开
+      while (length > 0) {
+        auto p = static_cast<std::int32_t>(offset) / width;
+        auto x = static_cast<std::int32_t>(offset) - p * width;
+        auto n = static_cast<std::uint32_t>(width - x) < length
+                     ? static_cast<std::uint32_t>(width - x)
+                     : length;
+        std::copy(bytes, bytes + n, frame_.data() + offset);
+        if (p != page) {
+          flush();
+          page = p;
+          x0 = x;
+          x1 = x;
+        }
+        x0 = x < x0 ? x : x0;
+        x1 = x + static_cast<std::int32_t>(n) > x1
+                 ? x + static_cast<std::int32_t>(n)
+                 : x1;
+        bytes += n;
+        offset += n;
+        length -= n;
+      }
+    }
+    flush();
+    return cursor;
+  }
+
+  void _damage(const Rect& rect) {
+    if (context_ == nullptr) {
+      this->invalidate();
+    } else {
+      context_->invalidate(rect);
+    }
+  }
+
+  static void _on_frame(void* data) {
+    auto* self = static_cast<Animation*>(data);
+    if (self->restart_.exchange(false)) {
+      self->elapsed_ = 0;
+    }
+    auto interval = self->interval_.load();
+    if (interval != 0 && ++self->elapsed_ >= interval) {
+      self->elapsed_ = 0;
+      self->advance();
+    }
+    self->context_->on_next_frame(&Animation::_on_frame, self);
+  }
+
+ public:
+  /**
+   * @param animation 动画，数据需要在组件的生命周期内有效
+   * @param position 左上角
+   */
+  Animation(Graphics::DeltaAnimation animation,
+            Geometry::Point<std::int32_t> position)
+      : SSDUI::Context::Node<Pl>(
+            {position, {animation.width, animation.height()}}),
+        animation_(animation),
+        frame_(animation.empty() ? 0U
+                                 : static_cast<std::size_t>(animation.width *
+                                                            animation.pages)) {
+    if (!animation_.empty()) {
+      first_delta_ = _apply(0, false);
+      cursor_ = first_delta_;
+    }
+  }
+
+  Animation(const Animation&) = delete;
+  Animation& operator=(const Animation&) = delete;
+  Animation(Animation&&) = delete;
+  Animation& operator=(Animation&&) = delete;
+
+  /**
+   * @brief 挂载后每帧发送完成时检查是否需要切换
+   *        组件需要在上下文的生命周期内有效
+   */
+  void on_mount(SSDUI::Context::Context<Pl>* context) override {
+    if (context_ == nullptr) {
+      context->on_next_frame(&Animation::_on_frame, this);
+    }
+    context_ = context;
+    SSDUI::Context::Node<Pl>::on_mount(context);
+  }
+
+  /**
+   * @brief 开始播放，可以在任意线程（包括事件回调）中调用，
+   *        在下一次帧回调时生效
+   *
+   * @param interval 每隔多少个显示帧切换一次动画帧
+   * @param loop 播放到最后一帧后是否回到第 0 帧
+   */
+  void play(std::uint32_t interval = 1, bool loop = true) {
+    loop_ = loop;
+    restart_ = true;
+    interval_ = interval;
+  }
+
+  /**
+   * @brief 暂停播放，可以在任意线程中调用
+   */
+  void stop() { interval_ = 0; }
+
+  /**
+   * @brief 切换到下一帧，会写入当前画面并报告损坏区域，只能在渲染线程
+   *        （挂载时或帧回调中）调用；事件回调运行在事件线程，
+   *        用 Context::on_next_frame 推迟到帧回调
+   *
+   * @return bool 不循环且已经在最后一帧时返回 false
+   */
+  bool advance() {
+    if (animation_.empty()) {
+      return false;
+    }
+    if (index_ + 1U >= animation_.frames && !loop_) {
+      interval_ = 0;
+      return false;
+    }
+    cursor_ = _apply(cursor_, true);
+    if (++index_ == animation_.frames) {
+      index_ = 0;
+      cursor_ = first_delta_;
+    }
+    return true;
+  }
+
+  [[nodiscard]] std::uint16_t index() const { return index_; }
+  [[nodiscard]] std::uint16_t frames() const { return animation_.frames; }
+
+  void draw(SSDUI::Context::Context<Pl>* context) override {
+    if (frame_.empty()) {
+      return;
+    }
+    context->surface().blit(
+        Graphics::Bitmap{frame_.data(), animation_.width, animation_.pages},
+        this->bounds().origin, Graphics::RasterOp::Or);
+  }
+};
+
+}  // namespace SSDUI::Components
@@ -0,0 +1,165 @@
+#pragma once
+
+/**
+ *  灰度图片组件
+ *
+ *  把 8 位灰度图像（摄像头、文件或运行时生成的数据）抖动为 1 位保存在节点中，
+ *  绘制时与 Animation 相同直接复制，不再重复抖动。
+ *
+ *  灰度数据逐行送入 Ditherer，结果直接写入保存的页格式画面：
+ *  从字节源读取时只需要一行的缓冲（构造时分配，更新时不分配内存），
+ *  摄像头等逐行产生数据的来源可以用 begin / push 边读出边处理，
+ *  整幅灰度图不需要同时放在内存中。
+ *
+ *  画面在渲染线程中读取，所有更新函数只能在渲染线程（挂载时或帧回调中）调用；
+ *  数据在其他线程产生时，用 Context::on_next_frame 推迟到帧回调。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ssdui/common/span.hh"
+#include "ssdui/context/node.hh"
+#include "ssdui/geometry/point.hh"
+#include "ssdui/graphics/bitmap.hh"
+#include "ssdui/graphics/byte_source.hh"
+#include "ssdui/graphics/dither.hh"
+
+namespace SSDUI::Components {
+
+template <typename Pl>
+class DitheredImage : public SSDUI::Context::Node<Pl> {
+ private:
+  Graphics::Ditherer ditherer_;
+  std::int32_t height_;
+  std::int32_t pages_;
+  std::vector<std::uint8_t> frame_;
+  Graphics::RasterOp op_;
+
+  /**
+   * @brief 从字节源读取一行的缓冲
+   */
+  std::vector<std::uint8_t> line_;
+
+  /**
+   * @brief 下一次 push 的行
+   */
+  std::int32_t row_{0};
+
+ public:
+  /**
+   * @param width 宽度（像素）
+   * @param height 高度（像素）
+   * @param position 左上角
+   * @param method 抖动方式
+   * @param op 光栅操作
+   */
+  DitheredImage(std::int32_t width, std::int32_t height,
+                Geometry::Point<std::int32_t> position,
+                Graphics::Dither method = Graphics::Dither::FloydSteinberg,
+                Graphics::RasterOp op = Graphics::RasterOp::Or)
+      : SSDUI::Context::Node<Pl>({position, {width, height}}),
+        ditherer_(width, method),
+        height_(height > 0 ? height : 0),
+        pages_((height_ + 7) / 8),
+        frame_(static_cast<std::size_t>(ditherer_.width()) *
+               static_cast<std::size_t>(pages_)),
+        op_(op),
+        line_(static_cast<std::size_t>(ditherer_.width())) {}
+
+  DitheredImage(const DitheredImage&) = delete;
+  DitheredImage& operator=(const DitheredImage&) = delete;
+  DitheredImage(DitheredImage&&) = delete;
+  DitheredImage& operator=(DitheredImage&&) = delete;
+
+  /**
+   * @brief 修改抖动方式，下一次更新时生效
+   */
+  void set_method(Graphics::Dither method) { ditherer_.set_method(method); }
+
+  /**
+   * @brief 开始逐行送入新的一帧，只能在渲染线程调用
+   */
+  void begin() {
+    ditherer_.reset();
+    row_ = 0;
+  }
+
+  /**
+   * @brief 送入下一行，最后一行送入后标记重绘，只能在渲染线程调用
+   *
+   * @param gray 本行的灰度，不少于 width 个字节
+   * @return bool 行的长度不够或一帧已经结束时返回 false
+   */
+  bool push(std::span<const std::uint8_t> gray) {
+    auto width = static_cast<std::size_t>(ditherer_.width());
+    if (row_ >= height_ || gray.size() < width) {
+      return false;
+    }
+    auto* page = frame_.data() + static_cast<std::size_t>(row_ / 8) * width;
+    ditherer_.row(gray.data(), page,
+                  static_cast<std::uint8_t>(1U << (row_ % 8)));
+    if (++row_ == height_) {
+      this->invalidate();
+    }
+    return true;
+  }
+
+  /**
+   * @brief 更新整幅图像，只能在渲染线程调用
+   *
+   * @param gray 灰度图像，第 y 行从 gray[y * stride] 开始
+   * @param stride 每行的字节数，0 表示与宽度相同
+   * @return bool 数据不够时不更新并返回 false
+   */
+  bool update(std::span<const std::uint8_t> gray, std::size_t stride = 0) {
+    auto width = static_cast<std::size_t>(ditherer_.width());
+    stride = stride == 0 ? width : stride;
+    if (height_ == 0) {
+      return true;
+    }
+    if (stride < width ||
+        gray.size() < static_cast<std::size_t>(height_ - 1) * stride + width) {
+      return false;
+    }
+    begin();
+    for (std::int32_t y = 0; y < height_; y++) {
+      push(gray.subspan(static_cast<std::size_t>(y) * stride, width));
+    }
+    return true;
+  }
+
+  /**
+   * @brief 从字节源逐行读取并更新，只能在渲染线程调用
+   *
+   * @param source 字节源，灰度按行连续存放
+   * @param offset 第 0 行的位置
+   * @return bool 读取失败时返回 false，已经读取的行保留
+   */
+  template <Graphics::IsByteSource So>
+  bool update(const So& source, std::size_t offset = 0) {
+    auto width = line_.size();
+    begin();
+    for (std::int32_t y = 0; y < height_; y++) {
+      if (source.read(offset + static_cast<std::size_t>(y) * width, line_) !=
+          width) {
+        this->invalidate();
+        return false;
+      }
+      push(line_);
+    }
+    return true;
+  }
+
+  void draw(SSDUI::Context::Context<Pl>* context) override {
+    if (frame_.empty()) {
+      return;
+    }
+    context->surface().blit(
+        Graphics::Bitmap{frame_.data(), ditherer_.width(), pages_},
+        this->bounds().origin, op_);
+  }
+};
+
+}  // namespace SSDUI::Components
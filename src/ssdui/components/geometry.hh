@@ -1,11 +1,23 @@
 #pragma once
 
+/**
+ *  立即模式的几何图元组件，绘制由 Graphics::Surface 完成，
+ *  每个图元只与当前裁剪区域求交一次；
+ *  圆、椭圆、圆弧、圆角矩形与多边形逐行输出水平区间，不逐点绘制
+ */
+
 #include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
 
 #include "ssdui/context/component.hh"
 #include "ssdui/geometry/line.hh"
 #include "ssdui/geometry/point.hh"
 #include "ssdui/geometry/rectangle.hh"
+#include "ssdui/graphics/pattern.hh"
+#include "ssdui/graphics/polygon.hh"
+
 namespace SSDUI::Components {
 
 template <typename Pl>
@@ -23,11 +35,7 @@ class Point : public SSDUI::Context::BaseComponent<Pl> {
   Point& operator=(Point&&) = delete;
 
   void operator()(SSDUI::Context::Context<Pl>* context) override {
-    if (point_.x < 0 || point_.x >= context->config().width || point_.y < 0 ||
-        point_.y >= context->config().height) {
-      return;
-    }
-    context->buffer().mixin(point_.x, point_.y / 8, 0x01U << (point_.y % 8U));
+    context->surface().pixel(point_.x, point_.y);
   }
 };
 
@@ -35,9 +43,15 @@ template <typename Pl>
 class Line : public SSDUI::Context::BaseComponent<Pl> {
  private:
   Geometry::Line<int32_t> line_;
+  int32_t width_;
 
  public:
-  explicit Line(Geometry::Line<int32_t> line) : line_(line) {}
+  /**
+   * @param line 包含两端点的线段
+   * @param width 线宽，大于 1 时按多边形填充，两端为方头
+   */
+  explicit Line(Geometry::Line<int32_t> line, int32_t width = 1)
+      : line_(line), width_(width) {}
   virtual ~Line() = default;
 
   Line(const Line&) = delete;
@@ -46,40 +60,10 @@ class Line : public SSDUI::Context::BaseComponent<Pl> {
   Line& operator=(Line&&) = delete;
 
   void operator()(SSDUI::Context::Context<Pl>* context) override {
-    auto [start, end] = line_;
-    int32_t dx = end.x - start.x;
-    int32_t dy = end.y - start.y;
-    int32_t x = start.x;
-    int32_t y = start.y;
-    int32_t x_inc = (dx < 0) ? -1 : 1;
-    int32_t y_inc = (dy < 0) ? -1 : 1;
-    dx = (dx < 0) ? -dx : dx;
-    dy = (dy < 0) ? -dy : dy;
-
-    if (dx > dy) {
-      int32_t p = 2 * dy - dx;
-      for (int32_t i = 0; i <= dx; i++) {
-        // context->buffer().mixing(x, y / 8, 0x01 << (y % 8));
-        Point<Pl>(Geometry::Point<int32_t>(x, y))(context);
-        if (p >= 0) {
-          y += y_inc;
-          p -= 2 * dx;
-        }
-        x += x_inc;
-        p += 2 * dy;
-      }
+    if (width_ > 1) {
+      context->surface().stroke(line_, width_);
     } else {
-      int32_t p = 2 * dx - dy;
-      for (int32_t i = 0; i <= dy; i++) {
-        // context->buffer().mixing(x, y / 8, 0x01 << (y % 8));
-        Point<Pl>(Geometry::Point<int32_t>(x, y))(context);
-        if (p >= 0) {
-          x += x_inc;
-          p -= 2 * dy;
-        }
-        y += y_inc;
-        p += 2 * dx;
-      }
+      context->surface().line(line_);
     }
   }
 };
@@ -88,10 +72,17 @@ template <typename Pl>
 class Rectangle : public SSDUI::Context::BaseComponent<Pl> {
  private:
   Geometry::Rectangle<int32_t> rectangle_;
+  std::optional<Graphics::Pattern> pattern_{};
 
  public:
   explicit Rectangle(Geometry::Rectangle<int32_t> rectangle)
       : rectangle_(rectangle) {}
+
+  /**
+   * @param pattern 填充图案，例如进度条的底色 Pattern::gray(16)
+   */
+  Rectangle(Geometry::Rectangle<int32_t> rectangle, Graphics::Pattern pattern)
+      : rectangle_(rectangle), pattern_(pattern) {}
   virtual ~Rectangle() = default;
 
   Rectangle(const Rectangle&) = delete;
@@ -100,13 +91,12 @@ class Rectangle : public SSDUI::Context::BaseComponent<Pl> {
   Rectangle& operator=(Rectangle&&) = delete;
 
   void operator()(SSDUI::Context::Context<Pl>* context) override {
-    // solid rectangle
-    auto [origin, size] = rectangle_;
-    for (int32_t x = origin.x; x < origin.x + size.x; x++) {
-      for (int32_t y = origin.y; y < origin.y + size.y; y++) {
-        Point<Pl>(Geometry::Point<int32_t>(x, y))(context);
-      }
+    if (pattern_) {
+      context->surface().fill(rectangle_, *pattern_);
+      return;
     }
+    // solid rectangle
+    context->surface().fill(rectangle_);
   }
 };
 
@@ -127,14 +117,160 @@ class Frame : public SSDUI::Context::BaseComponent<Pl> {
 
   void operator()(SSDUI::Context::Context<Pl>* context) override {
     // frame
-    auto [origin, size] = rectangle_;
-    for (int32_t x = origin.x; x < origin.x + size.x; x++) {
-      Point<Pl>(Geometry::Point<int32_t>(x, origin.y))(context);
-      Point<Pl>(Geometry::Point<int32_t>(x, origin.y + size.y - 1))(context);
+    context->surface().frame(rectangle_);
+  }
+};
+
+template <typename Pl>
+class Polygon : public SSDUI::Context::BaseComponent<Pl> {
+ private:
+  std::vector<Geometry::Point<int32_t>> points_;
+  Graphics::FillRule rule_;
+  std::optional<Graphics::Pattern> pattern_{};
+
+ public:
+  /**
+   * @param points 顶点，像素的角点，首尾自动相连，
+   *               不超过 Graphics::MAX_POLYGON_VERTICES 个
+   * @param rule 填充规则
+   */
+  explicit Polygon(std::vector<Geometry::Point<int32_t>> points,
+                   Graphics::FillRule rule = Graphics::FillRule::NonZero)
+      : points_(std::move(points)), rule_(rule) {}
+
+  Polygon(std::vector<Geometry::Point<int32_t>> points,
+          Graphics::FillRule rule, Graphics::Pattern pattern)
+      : points_(std::move(points)), rule_(rule), pattern_(pattern) {}
+  virtual ~Polygon() = default;
+
+  Polygon(const Polygon&) = delete;
+  Polygon& operator=(const Polygon&) = delete;
+  Polygon(Polygon&&) = delete;
+  Polygon& operator=(Polygon&&) = delete;
+
+  void operator()(SSDUI::Context::Context<Pl>* context) override {
+    if (pattern_) {
+      context->surface().polygon({points_.data(), points_.size()}, rule_,
+                                 *pattern_);
+    } else {
+      context->surface().polygon({points_.data(), points_.size()}, rule_);
     }
-    for (int32_t y = origin.y; y < origin.y + size.y; y++) {
-      Point<Pl>(Geometry::Point<int32_t>(origin.x, y))(context);
-      Point<Pl>(Geometry::Point<int32_t>(origin.x + size.x - 1, y))(context);
+  }
+};
+
+template <typename Pl>
+class Circle : public SSDUI::Context::BaseComponent<Pl> {
+ private:
+  Geometry::Point<int32_t> center_;
+  int32_t radius_;
+  bool filled_;
+
+ public:
+  Circle(Geometry::Point<int32_t> center, int32_t radius, bool filled = false)
+      : center_(center), radius_(radius), filled_(filled) {}
+  virtual ~Circle() = default;
+
+  Circle(const Circle&) = delete;
+  Circle& operator=(const Circle&) = delete;
+  Circle(Circle&&) = delete;
+  Circle& operator=(Circle&&) = delete;
+
+  void operator()(SSDUI::Context::Context<Pl>* context) override {
+    if (filled_) {
+      context->surface().fill_circle(center_, radius_);
+    } else {
+      context->surface().circle(center_, radius_);
+    }
+  }
+};
+
+template <typename Pl>
+class Ellipse : public SSDUI::Context::BaseComponent<Pl> {
+ private:
+  Geometry::Rectangle<int32_t> box_;
+  bool filled_;
+
+ public:
+  /**
+   * @param box 椭圆的包围盒
+   * @param filled 是否填充
+   */
+  explicit Ellipse(Geometry::Rectangle<int32_t> box, bool filled = false)
+      : box_(box), filled_(filled) {}
+  virtual ~Ellipse() = default;
+
+  Ellipse(const Ellipse&) = delete;
+  Ellipse& operator=(const Ellipse&) = delete;
+  Ellipse(Ellipse&&) = delete;
+  Ellipse& operator=(Ellipse&&) = delete;
+
+  void operator()(SSDUI::Context::Context<Pl>* context) override {
+    if (filled_) {
+      context->surface().fill_ellipse(box_);
+    } else {
+      context->surface().ellipse(box_);
+    }
+  }
+};
+
+template <typename Pl>
+class Arc : public SSDUI::Context::BaseComponent<Pl> {
+ private:
+  Geometry::Rectangle<int32_t> box_;
+  int32_t start_;
+  int32_t sweep_;
+  int32_t thickness_;
+
+ public:
+  /**
+   * @param box 外侧椭圆的包围盒
+   * @param start 起始角度（度），0 度指向右侧，顺时针增加
+   * @param sweep 扫过的角度，负数为逆时针
+   * @param thickness 向内的宽度，用于仪表盘等粗弧
+   */
+  Arc(Geometry::Rectangle<int32_t> box, int32_t start, int32_t sweep,
+      int32_t thickness = 1)
+      : box_(box), start_(start), sweep_(sweep), thickness_(thickness) {}
+  virtual ~Arc() = default;
+
+  Arc(const Arc&) = delete;
+  Arc& operator=(const Arc&) = delete;
+  Arc(Arc&&) = delete;
+  Arc& operator=(Arc&&) = delete;
+
+  /**
+   * @brief 修改扫过的角度，例如仪表盘的读数
+   */
+  void set_sweep(int32_t sweep) { sweep_ = sweep; }
+
+  void operator()(SSDUI::Context::Context<Pl>* context) override {
+    context->surface().arc(box_, start_, sweep_, thickness_);
+  }
+};
+
+template <typename Pl>
+class RoundedRectangle : public SSDUI::Context::BaseComponent<Pl> {
+ private:
+  Geometry::Rectangle<int32_t> rectangle_;
+  int32_t radius_;
+  bool filled_;
+
+ public:
+  RoundedRectangle(Geometry::Rectangle<int32_t> rectangle, int32_t radius,
+                   bool filled = false)
+      : rectangle_(rectangle), radius_(radius), filled_(filled) {}
+  virtual ~RoundedRectangle() = default;
+
+  RoundedRectangle(const RoundedRectangle&) = delete;
+  RoundedRectangle& operator=(const RoundedRectangle&) = delete;
+  RoundedRectangle(RoundedRectangle&&) = delete;
+  RoundedRectangle& operator=(RoundedRectangle&&) = delete;
+
+  void operator()(SSDUI::Context::Context<Pl>* context) override {
+    if (filled_) {
+      context->surface().rounded_fill(rectangle_, radius_);
+    } else {
+      context->surface().rounded_frame(rectangle_, radius_);
     }
   }
 };
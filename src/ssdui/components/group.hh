@@ -0,0 +1,69 @@
+#pragma once
+
+/**
+ *  静态组件树
+ *
+ *  Group 在编译期确定子组件的类型与数量，子组件按值保存在 std::tuple 中，
+ *  绘制时以限定名直接调用子组件，不经过虚函数表，
+ *  整棵静态树可以被内联为一个渲染函数，常量几何参数也可以被折叠。
+ *
+ *  Group 本身满足 IsComponent，可以嵌套；
+ *  需要动态增删的子树仍然使用 BaseComponent。
+ *  挂载为根组件时使用 InlineComponent 适配。
+ */
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "ssdui/context/component.hh"
+
+namespace SSDUI::Components {
+
+template <typename Pl, typename... Cm>
+  requires(SSDUI::Context::IsComponent<Pl, Cm> && ...)
+class Group {
+ private:
+  std::tuple<Cm...> children_;
+
+  // 限定名调用，保证静态分派
+  template <typename C>
+  static void _draw(C& child, SSDUI::Context::Context<Pl>* ctx) {
+    child.C::operator()(ctx);
+  }
+
+  template <typename C>
+  static void _mount(C& child, SSDUI::Context::Context<Pl>* ctx) {
+    child.C::on_mount(ctx);
+  }
+
+ public:
+  Group() = default;
+
+  /**
+   * @brief 依次用每个参数构造对应的子组件
+   */
+  template <typename... Args>
+    requires(sizeof...(Args) == sizeof...(Cm) && sizeof...(Args) > 0)
+  explicit Group(Args&&... args) : children_(std::forward<Args>(args)...) {}
+
+  void operator()(SSDUI::Context::Context<Pl>* ctx) {
+    std::apply([ctx](auto&... child) { (_draw(child, ctx), ...); },
+               children_);
+  }
+
+  void on_mount(SSDUI::Context::Context<Pl>* ctx) {
+    std::apply([ctx](auto&... child) { (_mount(child, ctx), ...); },
+               children_);
+  }
+
+  /**
+   * @brief 获取第 I 个子组件
+   */
+  template <std::size_t I>
+  auto& get() {
+    return std::get<I>(children_);
+  }
+};
+
+}  // namespace SSDUI::Components
@@ -0,0 +1,52 @@
+#pragma once
+
+/**
+ *  立即模式的压缩图片组件
+ *
+ *  图片以 PackBits 压缩保存（tools/packimage.py 从 PBM 或 PNG 生成），
+ *  绘制时边解码边合成到表面上，适合启动画面、图标集等占用 flash 较多的位图。
+ *  需要频繁重绘的小图标用 Sprite 更快。
+ */
+
+#include <cstdint>
+
+#include "ssdui/context/component.hh"
+#include "ssdui/geometry/point.hh"
+#include "ssdui/graphics/bitmap.hh"
+
+namespace SSDUI::Components {
+
+template <typename Pl>
+class Image : public SSDUI::Context::BaseComponent<Pl> {
+ private:
+  Graphics::PackedBitmap image_;
+  Geometry::Point<int32_t> position_;
+  Graphics::RasterOp op_;
+
+ public:
+  /**
+   * @param image 压缩位图，数据需要在组件的生命周期内有效
+   * @param position 左上角
+   * @param op 光栅操作，全屏图片通常用 Set 覆盖背景
+   */
+  Image(Graphics::PackedBitmap image, Geometry::Point<int32_t> position,
+        Graphics::RasterOp op = Graphics::RasterOp::Or)
+      : image_(image), position_(position), op_(op) {}
+  virtual ~Image() = default;
+
+  Image(const Image&) = delete;
+  Image& operator=(const Image&) = delete;
+  Image(Image&&) = delete;
+  Image& operator=(Image&&) = delete;
+
+  void set_image(Graphics::PackedBitmap image) { image_ = image; }
+  void set_position(Geometry::Point<int32_t> position) {
+    position_ = position;
+  }
+
+  void operator()(SSDUI::Context::Context<Pl>* context) override {
+    context->surface().blit(image_, position_, op_);
+  }
+};
+
+}  // namespace SSDUI::Components
@@ -0,0 +1,178 @@
+#pragma once
+
+/**
+ *  增量更新的文本标签
+ *
+ *  标签记住上一次显示的每个字符及其位置。更新文本时逐个比较字符单元，
+ *  只把字符或位置发生变化的单元报告为损坏区域（Context::invalidate），
+ *  没有变化的字形保留在帧缓冲中，不再重新绘制。
+ *  适用于计数器、时钟、读数等频繁变化的文本。
+ *
+ *  文本保存在固定容量的数组中，数字用 std::to_chars 格式化，
+ *  更新过程不分配内存。超出容量或包围盒宽度的字符被截断。
+ */
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "ssdui/context/node.hh"
+#include "ssdui/geometry/rectangle.hh"
+#include "ssdui/graphics/font.hh"
+#include "ssdui/graphics/utf8.hh"
+
+namespace SSDUI::Components {
+
+/**
+ * @tparam Pl 平台
+ * @tparam Capacity 最多显示的字符数
+ * @tparam Fo 字体类型，需要提供 find、bitmap、kerning、blank 与 height
+ */
+template <typename Pl, std::size_t Capacity,
+          typename Fo = const Graphics::Font>
+class Label : public SSDUI::Context::Node<Pl> {
+ public:
+  using Rect = Geometry::Rectangle<std::int32_t>;
+
+ private:
+  /**
+   * @brief 字符单元，pen 为笔位置，[x, x + width) 为单元覆盖的范围，
+   *        都相对于包围盒左侧
+   */
+  struct Cell {
+    char32_t codepoint;
+    std::int32_t pen;
+    std::int32_t x;
+    std::int32_t width;
+  };
+
+  Fo& font_;
+  std::array<Cell, Capacity> cells_{};
+  std::size_t count_{0};
+  SSDUI::Context::Context<Pl>* context_{nullptr};
+
+  [[nodiscard]] Rect _rect(const Cell& cell) const {
+    const auto& bounds = this->bounds();
+    return {{bounds.origin.x + cell.x, bounds.origin.y},
+            {cell.width, bounds.size.y}};
+  }
+
+  /**
+   * @brief 报告发生变化的单元，未挂载时整体失效
+   */
+  void _damage(const Rect& rect) {
+    if (context_ == nullptr) {
+      this->invalidate();
+    } else if (!rect.empty()) {
+      context_->invalidate(rect);
+    }
+  }
+
+ public:
+  /**
+   * @param font 字体，需要在组件的生命周期内有效
+   * @param bounds 包围盒，文本从左上角开始绘制
+   */
+  Label(Fo& font, Rect bounds)
+      : SSDUI::Context::Node<Pl>(bounds), font_(font) {}
+
+  Label(const Label&) = delete;
+  Label& operator=(const Label&) = delete;
+  Label(Label&&) = delete;
+  Label& operator=(Label&&) = delete;
+
+  void on_mount(SSDUI::Context::Context<Pl>* context) override {
+    context_ = context;
+    SSDUI::Context::Node<Pl>::on_mount(context);
+  }
+
+  /**
+   * @brief 更新文本，draw 会读取字符单元，只能在渲染线程（挂载时或帧回调中）
+   *        调用；事件回调运行在事件线程，用 Context::on_next_frame 推迟到帧回调
+   *
+   * @param text UTF-8 文本
+   */
+  void set(std::string_view text) {
+    std::array<Cell, Capacity> cells{};
+    std::size_t count = 0;
+    std::int32_t x = 0;
+    char32_t previous = 0;
+    while (!text.empty() && count < Capacity) {
+      auto codepoint = Graphics::next_codepoint(text);
+      x += font_.kerning(previous, codepoint);
+      previous = codepoint;
+
+      const auto* glyph = font_.find(codepoint);
+      std::int32_t advance = font_.blank();
+      std::int32_t left = 0;
+      std::int32_t right = advance;
+      if (glyph != nullptr) {
+        advance = glyph->advance;
+        // 墨迹可能超出前进宽度，单元覆盖两者的并集
+        left = glyph->width != 0 && glyph->left < 0 ? glyph->left : 0;
+        right = glyph->left + glyph->width > advance
+                    ? glyph->left + glyph->width
+                    : advance;
+      }
+      if (x + right > this->bounds().size.x) {
+        break;
+      }
+      cells[count++] = Cell{codepoint, x, x + left, right - left};
+      x += advance;
+    }
+
+    for (std::size_t i = 0; i < (count > count_ ? count : count_); i++) {
+      if (i >= count) {
+        _damage(_rect(cells_[i]));
+      } else if (i >= count_) {
+        _damage(_rect(cells[i]));
+      } else if (cells[i].codepoint != cells_[i].codepoint ||
+                 cells[i].pen != cells_[i].pen) {
+        _damage(_rect(cells_[i]).united(_rect(cells[i])));
+      }
+    }
+    cells_ = cells;
+    count_ = count;
+  }
+
+  /**
+   * @brief 以十进制显示整数
+   */
+  template <typename T>
+    requires std::is_integral_v<T>
+  void set(T value) {
+    std::array<char, 24> buffer{};
+    auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                                value);
+    set(std::string_view(buffer.data(),
+                         static_cast<std::size_t>(result.ptr - buffer.data())));
+  }
+
+  void clear() { set(std::string_view{}); }
+
+  [[nodiscard]] std::size_t size() const { return count_; }
+
+  void draw(SSDUI::Context::Context<Pl>* context) override {
+    auto surface = context->surface();
+    const auto& bounds = this->bounds();
+    const auto& clip = surface.clip();
+    for (std::size_t i = 0; i < count_; i++) {
+      // 局部重绘时跳过与裁剪区域不相交的单元
+      if (!_rect(cells_[i]).intersects(clip)) {
+        continue;
+      }
+      const auto* glyph = font_.find(cells_[i].codepoint);
+      if (glyph == nullptr || glyph->width == 0) {
+        continue;
+      }
+      surface.blit(font_.bitmap(*glyph),
+                   {bounds.origin.x + cells_[i].pen + glyph->left,
+                    bounds.origin.y + glyph->top * 8});
+    }
+  }
+};
+
+}  // namespace SSDUI::Components
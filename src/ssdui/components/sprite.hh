@@ -0,0 +1,70 @@
+#pragma once
+
+/**
+ *  立即模式的位图组件
+ *
+ *  位图为页格式，与帧缓冲相同，按字节整列复制；
+ *  纵向对齐页且不被裁剪时，每页一行以 32 位字为单位合成。
+ *  带掩码的精灵只改变掩码为 1 的像素，其余像素透明。
+ */
+
+#include <cstdint>
+#include <optional>
+
+#include "ssdui/context/component.hh"
+#include "ssdui/geometry/point.hh"
+#include "ssdui/graphics/bitmap.hh"
+
+namespace SSDUI::Components {
+
+template <typename Pl>
+class Sprite : public SSDUI::Context::BaseComponent<Pl> {
+ private:
+  Graphics::Bitmap image_;
+  std::optional<Graphics::Bitmap> mask_{};
+  Geometry::Point<int32_t> position_;
+  Graphics::RasterOp op_{Graphics::RasterOp::Or};
+
+ public:
+  /**
+   * @param image 位图，数据需要在组件的生命周期内有效
+   * @param position 左上角
+   * @param op 光栅操作
+   */
+  Sprite(Graphics::Bitmap image, Geometry::Point<int32_t> position,
+         Graphics::RasterOp op = Graphics::RasterOp::Or)
+      : image_(image), position_(position), op_(op) {}
+
+  /**
+   * @param image 位图
+   * @param mask 透明度掩码，尺寸与位图相同
+   * @param position 左上角
+   */
+  Sprite(Graphics::Bitmap image, Graphics::Bitmap mask,
+         Geometry::Point<int32_t> position)
+      : image_(image), mask_(mask), position_(position) {}
+  virtual ~Sprite() = default;
+
+  Sprite(const Sprite&) = delete;
+  Sprite& operator=(const Sprite&) = delete;
+  Sprite(Sprite&&) = delete;
+  Sprite& operator=(Sprite&&) = delete;
+
+  /**
+   * @brief 切换显示的位图，用于逐帧动画
+   */
+  void set_image(Graphics::Bitmap image) { image_ = image; }
+  void set_position(Geometry::Point<int32_t> position) {
+    position_ = position;
+  }
+
+  void operator()(SSDUI::Context::Context<Pl>* context) override {
+    if (mask_) {
+      context->surface().blit(image_, *mask_, position_);
+    } else {
+      context->surface().blit(image_, position_, op_);
+    }
+  }
+};
+
+}  // namespace SSDUI::Components
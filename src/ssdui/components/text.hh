@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+ *  立即模式的文本组件
+ *
+ *  字形以整字节复制到表面上，y 不对齐页时每列移位后写入相邻的两页，
+ *  每个字形只需 width * (pages + 1) 次字节操作。
+ *  文本为 UTF-8，字距调整在相邻的两个字形之间生效。
+ *
+ *  字体可以是 Graphics::Font，也可以是 Graphics::FlashFont 等带缓存的字体。
+ *  后者的字形位于会被淘汰的缓存中，
+ *  不能用在缓存显示列表（Cache::List）的节点里。
+ */
+
+#include <cstdint>
+#include <string_view>
+
+#include "ssdui/context/component.hh"
+#include "ssdui/geometry/point.hh"
+#include "ssdui/graphics/font.hh"
+
+namespace SSDUI::Components {
+
+/**
+ * @tparam Pl 平台
+ * @tparam Fo 字体类型，需要提供 find、bitmap、kerning 与 blank
+ */
+template <typename Pl, typename Fo = const Graphics::Font>
+class Text : public SSDUI::Context::BaseComponent<Pl> {
+ private:
+  Fo& font_;
+  std::string_view text_;
+  Geometry::Point<int32_t> position_;
+
+ public:
+  /**
+   * @param font 字体，需要在组件的生命周期内有效
+   * @param text 文本，不复制，需要在组件的生命周期内有效
+   * @param position 左上角
+   */
+  Text(Fo& font, std::string_view text, Geometry::Point<int32_t> position)
+      : font_(font), text_(text), position_(position) {}
+  virtual ~Text() = default;
+
+  Text(const Text&) = delete;
+  Text& operator=(const Text&) = delete;
+  Text(Text&&) = delete;
+  Text& operator=(Text&&) = delete;
+
+  void operator()(SSDUI::Context::Context<Pl>* context) override {
+    auto surface = context->surface();
+    auto x = position_.x;
+    char32_t previous = 0;
+    for (auto text = text_; !text.empty();) {
+      auto codepoint = Graphics::next_codepoint(text);
+      x += font_.kerning(previous, codepoint);
+      previous = codepoint;
+
+      const auto* glyph = font_.find(codepoint);
+      if (glyph == nullptr) {
+        // 字库之外的字符留空
+        x += font_.blank();
+        continue;
+      }
+      if (glyph->width != 0) {
+        surface.blit(font_.bitmap(*glyph),
+                     {x + glyph->left, position_.y + glyph->top * 8});
+      }
+      x += glyph->advance;
+    }
+  }
+};
+
+}  // namespace SSDUI::Components
@@ -1,6 +1,13 @@
 #pragma once
 
 #include "ssdui/context/buffer.hh"
+#include "ssdui/context/clock.hh"
 #include "ssdui/context/component.hh"
 #include "ssdui/context/context.hh"
-#include "ssdui/context/event.hh"
\ No newline at end of file
+#include "ssdui/context/damage.hh"
+#include "ssdui/context/event.hh"
+#include "ssdui/context/node.hh"
+#include "ssdui/context/recorder.hh"
+#include "ssdui/context/scheduler.hh"
+#include "ssdui/context/trace.hh"
+#include "ssdui/context/trace_codec.hh"
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "ssdui/context/buffer.hh"
 
+#include <algorithm>
 #include <cstdint>
+#include <utility>
 
 namespace SSDUI::Context {
 
@@ -78,4 +80,20 @@ Buffer& Buffer::operator=(Buffer&& other) noexcept {
   return *this;
 }
 
+void Buffer::clear(const Geometry::Rectangle<std::int32_t>& region) noexcept {
+  Detail::clear_region(next_, std::int32_t{width_}, std::int32_t{height_},
+                       region);
+}
+
+std::vector<Geometry::Rectangle<std::int32_t>> Buffer::dirty_regions() const {
+  return Detail::dirty_regions(prev_, next_, std::int32_t{width_},
+                               std::int32_t{height_});
+}
+
+std::vector<Geometry::Rectangle<std::int32_t>> Buffer::dirty_regions(
+    std::span<const Geometry::Rectangle<std::int32_t>> areas) const {
+  return Detail::dirty_regions(prev_, next_, std::int32_t{width_},
+                               std::int32_t{height_}, areas);
+}
+
 }  // namespace SSDUI::Context
\ No newline at end of file
@@ -1,13 +1,125 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "HardwareSerial.h"
 #include "ssdui/common/span.hh"
+#include "ssdui/geometry/rectangle.hh"
 namespace SSDUI::Context {
 
+namespace Detail {
+
+/**
+ * 以下为 Buffer 与 StaticBuffer 共用的帧操作，width 为列数、pages 为页数。
+ * 两者可以是 std::int32_t，也可以是 std::integral_constant：
+ * 传入常量时每个实例化的下标运算与循环边界都在编译期确定。
+ */
+
+template <typename Wi, typename Pa>
+void clear_region(std::uint8_t* next, Wi width, Pa pages,
+                  const Geometry::Rectangle<std::int32_t>& region) noexcept {
+  auto x0 = std::max<std::int32_t>(region.origin.x, 0);
+  auto x1 = std::min<std::int32_t>(region.origin.x + region.size.x, width);
+  auto y0 = std::max<std::int32_t>(region.origin.y, 0);
+  auto y1 =
+      std::min<std::int32_t>(region.origin.y + region.size.y, pages * 8);
+  if (x0 >= x1 || y0 >= y1) {
+    return;
+  }
+
+  for (std::int32_t page = y0 / 8; page <= (y1 - 1) / 8; page++) {
+    // 本页内需要清除的行
+    auto top = std::max(y0 - page * 8, 0);
+    auto bottom = std::min(y1 - page * 8, 8);
+    auto mask = static_cast<std::uint8_t>((0xFFU << top) &
+                                          (0xFFU >> (8 - bottom)));
+
+    auto* row = next + page * width;
+    for (std::int32_t x = x0; x < x1; x++) {
+      row[x] &= static_cast<std::uint8_t>(~mask);
+    }
+  }
+}
+
+template <typename Wi, typename Pa>
+std::vector<Geometry::Rectangle<std::int32_t>> dirty_regions(
+    const std::uint8_t* prev, const std::uint8_t* next, Wi width, Pa pages) {
+  std::vector<Geometry::Rectangle<std::int32_t>> dirty_regions{};
+
+  for (std::int32_t y = 0; y < pages; y++) {
+    for (std::int32_t x = 0; x < width; x++) {
+      if (next[x + y * width] != prev[x + y * width]) {
+        std::int32_t start = x;
+        while (x < width && next[x + y * width] != prev[x + y * width]) {
+          x++;
+        }
+        dirty_regions.emplace_back(Geometry::Point<std::int32_t>{start, y},
+                                   Geometry::Point<std::int32_t>{x - start, 1});
+      }
+    }
+  }
+
+  return dirty_regions;
+}
+
+template <typename Wi, typename Pa>
+std::vector<Geometry::Rectangle<std::int32_t>> dirty_regions(
+    const std::uint8_t* prev, const std::uint8_t* next, Wi width, Pa pages,
+    std::span<const Geometry::Rectangle<std::int32_t>> areas) {
+  std::vector<Geometry::Rectangle<std::int32_t>> dirty_regions{};
+  // 每一页内需要比较的列区间 [first, second)
+  std::vector<std::pair<std::int32_t, std::int32_t>> spans{};
+
+  for (std::int32_t y = 0; y < pages; y++) {
+    spans.clear();
+    for (const auto& area : areas) {
+      if (area.empty() || area.origin.y >= (y + 1) * 8 ||
+          area.origin.y + area.size.y <= y * 8) {
+        continue;
+      }
+      auto begin = std::max<std::int32_t>(area.origin.x, 0);
+      auto end = std::min<std::int32_t>(area.origin.x + area.size.x, width);
+      if (begin < end) {
+        spans.emplace_back(begin, end);
+      }
+    }
+    std::sort(spans.begin(), spans.end());
+
+    std::int32_t scanned = 0;
+    for (auto [begin, end] : spans) {
+      // 区间可能在同一页内重叠，已比较过的列不再比较
+      for (std::int32_t x = std::max(begin, scanned); x < end; x++) {
+        if (next[x + y * width] != prev[x + y * width]) {
+          std::int32_t start = x;
+          while (x < end && next[x + y * width] != prev[x + y * width]) {
+            x++;
+          }
+          // 与相邻区间中的变化首尾相接时合并为一个区域
+          if (!dirty_regions.empty() && dirty_regions.back().origin.y == y &&
+              dirty_regions.back().origin.x + dirty_regions.back().size.x ==
+                  start) {
+            dirty_regions.back().size.x += x - start;
+            continue;
+          }
+          dirty_regions.emplace_back(
+              Geometry::Point<std::int32_t>{start, y},
+              Geometry::Point<std::int32_t>{x - start, 1});
+        }
+      }
+      scanned = std::max(scanned, end);
+    }
+  }
+
+  return dirty_regions;
+}
+
+}  // namespace Detail
+
 class Buffer {
  private:
   std::uint8_t* prev_;
@@ -43,6 +155,28 @@ class Buffer {
   }
   void clear() noexcept { std::fill(next_, next_ + width_ * height_, 0U); }
 
+  /**
+   * @brief 清除下一帧中的一个区域，区域以像素为单位，超出屏幕的部分被忽略
+   *
+   * @param region 区域
+   */
+  void clear(const Geometry::Rectangle<std::int32_t>& region) noexcept;
+
+  /**
+   * @brief 把下一帧复制到上一帧，下一帧保留当前内容
+   *        用于保留模式：只重绘变化的部分，其余像素沿用上一帧
+   */
+  void sync() noexcept { std::copy(next_, next_ + width_ * height_, prev_); }
+
+  /**
+   * @brief 使上一帧与下一帧的每个字节都不同，下一次比较时发送整个屏幕
+   */
+  void invalidate() noexcept {
+    for (std::int32_t i = 0; i < width_ * height_; i++) {
+      prev_[i] = static_cast<std::uint8_t>(~next_[i]);
+    }
+  }
+
   void set(std::int16_t x, std::int16_t y, std::uint8_t value) {
     next_[x + y * width_] = value;
   }
@@ -50,6 +184,25 @@ class Buffer {
   void mixin(std::int16_t x, std::int16_t y, std::uint8_t value) {
     next_[x + y * width_] |= value;
   }
+
+  /**
+   * @brief 比较前后两帧，得到需要发送的区域
+   *        每个区域为一页内连续变化的列，x 为列、y 为页，高度恒为 1
+   *
+   * @return std::vector<Geometry::Rectangle<std::int32_t>>
+   */
+  [[nodiscard]] std::vector<Geometry::Rectangle<std::int32_t>> dirty_regions()
+      const;
+
+  /**
+   * @brief 只在给定的区域内比较前后两帧，区域以像素为单位
+   *        区域之外的内容必须保证前后两帧一致
+   *
+   * @param areas 可能发生变化的区域
+   * @return std::vector<Geometry::Rectangle<std::int32_t>>
+   */
+  [[nodiscard]] std::vector<Geometry::Rectangle<std::int32_t>> dirty_regions(
+      std::span<const Geometry::Rectangle<std::int32_t>> areas) const;
 };
 
 }  // namespace SSDUI::Context
\ No newline at end of file
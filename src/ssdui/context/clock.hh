@@ -0,0 +1,45 @@
+#pragma once
+
+/**
+ *  SSDUI 时钟
+ *
+ *  上下文内所有服务（调度器、输入、追踪）共享同一时间基准
+ */
+
+#include <chrono>
+
+#if __has_include(<esp_timer.h>)
+#include <esp_timer.h>
+#define SSDUI_HAS_ESP_TIMER 1
+#endif
+
+/**
+ * @brief 中断中调用的函数放在 IRAM 中，flash 缓存关闭（写 flash）时仍可执行
+ */
+#if __has_include(<esp_attr.h>)
+#include <esp_attr.h>
+#define SSDUI_ISR_ATTR IRAM_ATTR
+#else
+#define SSDUI_ISR_ATTR
+#endif
+
+namespace SSDUI::Context {
+
+using Clock = std::chrono::steady_clock;
+using TimePoint = Clock::time_point;
+
+/**
+ * @brief 可在中断上下文调用的当前时间
+ *        steady_clock::now 经由 newlib 的 clock_gettime，不能在中断中调用；
+ *        ESP-IDF 的 steady_clock 与 esp_timer 都是开机以来的微秒数，
+ *        直接读取 esp_timer 得到的时间点与 Clock::now 可以比较
+ */
+inline SSDUI_ISR_ATTR TimePoint isr_now() {
+#ifdef SSDUI_HAS_ESP_TIMER
+  return TimePoint(std::chrono::microseconds(esp_timer_get_time()));
+#else
+  return Clock::now();
+#endif
+}
+
+}  // namespace SSDUI::Context
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 
 #include "ssdui/platform/concepts.hh"
 
@@ -10,6 +11,9 @@ template <typename Pl>
   requires Platform::IsPlatform<Pl>
 class Context;
 
+template <typename Pl>
+class Node;
+
 template <typename Pl, typename Cm>
 concept IsComponent = requires(Cm comp, Context<Pl> *ctx) {
   { comp(ctx) };
@@ -19,11 +23,19 @@ concept IsComponent = requires(Cm comp, Context<Pl> *ctx) {
 template <typename Pl>
 class BaseComponent {
  public:
+  virtual ~BaseComponent() = default;
+
   virtual void operator()(Context<Pl> *ctx) = 0;
   virtual void on_mount(Context<Pl> *ctx) {}
+
+  /**
+   * @brief 保留模式下的节点，普通组件返回 nullptr，每帧整体重绘
+   */
+  virtual Node<Pl> *as_node() { return nullptr; }
 };
 
-template <typename Pl, IsComponent<Pl> Cm>
+template <typename Pl, typename Cm>
+  requires IsComponent<Pl, Cm>
 class Component : public BaseComponent<Pl> {
   std::unique_ptr<Cm> comp_;
 
@@ -34,4 +46,24 @@ class Component : public BaseComponent<Pl> {
   void on_mount(Context<Pl> *ctx) override { comp_->on_mount(ctx); }
 };
 
+/**
+ * @brief 以值的方式持有组件的适配器，省去 Component 的一次间接访问
+ *        常用于把静态组件树挂载为根组件，整棵树只在根部有一次虚调用
+ */
+template <typename Pl, typename Cm>
+  requires IsComponent<Pl, Cm>
+class InlineComponent : public BaseComponent<Pl> {
+  Cm comp_;
+
+ public:
+  template <typename... Args>
+  explicit InlineComponent(Args &&...args)
+      : comp_(std::forward<Args>(args)...) {}
+
+  void operator()(Context<Pl> *ctx) override { comp_.Cm::operator()(ctx); }
+  void on_mount(Context<Pl> *ctx) override { comp_.Cm::on_mount(ctx); }
+
+  Cm &get() { return comp_; }
+};
+
 }  // namespace SSDUI::Context
\ No newline at end of file
@@ -1,17 +1,57 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "ssdui/context/buffer.hh"
+#include "ssdui/context/clock.hh"
 #include "ssdui/context/component.hh"
+#include "ssdui/context/damage.hh"
 #include "ssdui/context/event.hh"
+#include "ssdui/context/node.hh"
+#include "ssdui/context/recorder.hh"
+#include "ssdui/context/scheduler.hh"
+#include "ssdui/context/static_buffer.hh"
+#include "ssdui/context/trace.hh"
+#include "ssdui/geometry/rectangle.hh"
+#include "ssdui/graphics/bitmap_cache.hh"
+#include "ssdui/graphics/surface.hh"
 #include "ssdui/platform/concepts.hh"
 namespace SSDUI::Context {
 
 template <typename Pl>
 class Builder;
 
+template <typename Pl>
+class NextFrameAwaiter;
+
+template <typename Pl>
+class SleepAwaiter;
+
+template <typename Pl>
+class EventAwaiter;
+
+namespace Detail {
+
+/**
+ * @brief 平台声明了 Buffer 类型（例如 StaticBuffer）时使用它，否则使用 Buffer
+ */
+template <typename Pl>
+struct BufferOf {
+  using Type = Buffer;
+};
+
+template <typename Pl>
+  requires requires { typename Pl::Buffer; }
+struct BufferOf<Pl> {
+  using Type = typename Pl::Buffer;
+};
+
+}  // namespace Detail
+
 template <typename Pl>
   requires Platform::IsPlatform<Pl>
 class Context {
@@ -23,6 +63,12 @@ class Context {
   using Renderer = typename Platform::Renderer;
   using Config = typename Platform::Config;
   using Store = typename Platform::Store;
+  using Buffer = typename Detail::BufferOf<Pl>::Type;
+
+  /**
+   * @brief 帧回调，参数为注册时传入的数据
+   */
+  using FrameCallback = void (*)(void*);
 
  private:
   /**
@@ -42,10 +88,17 @@ class Context {
 
   /**
    * @brief Buffer，用于存储渲染结果
-   * TODO: 未来可能会支持不同种类的Buffer
+   *        平台可以通过 Pl::Buffer 指定编译期确定尺寸的 StaticBuffer，
+   *        帧存储在静态内存中，对象内只有帧的下标
    */
   Buffer buffer_;
 
+  /**
+   * @brief 逻辑坐标相对于 Buffer 的旋转，由 Config::rotation 指定（可选）
+   *        控制器只支持翻转，竖装的屏幕由绘制时换算坐标实现
+   */
+  Graphics::Rotation rotation_;
+
   /**
    * @brief 事件管理器，用于处理事件
    */
@@ -56,14 +109,178 @@ class Context {
    */
   Store store_{};
 
+  /**
+   * @brief 调度器，为组件提供共享的定时服务
+   */
+  Scheduler<Pl> scheduler_{};
+
+  /**
+   * @brief 输入到画面的延迟追踪，默认关闭
+   */
+  LatencyTracer tracer_{};
+
+  /**
+   * @brief 当前帧开始渲染的时刻（调度器的时钟），帧回调以它为触发时刻
+   */
+  TimePoint frame_time_{};
+
+  /**
+   * @brief 录制器，不分享所有权，为空时不录制
+   *        record 在调用者线程写入，render 在渲染线程读取，由 record_lock_ 保护
+   */
+  Recorder<Pl>* recorder_{nullptr};
+  std::mutex record_lock_;
+
+  /**
+   * @brief 等待下一帧的回调，每帧发送完成后调用并清空
+   */
+  std::vector<std::pair<FrameCallback, void*>> frame_callbacks_{};
+  std::vector<std::pair<FrameCallback, void*>> frame_callbacks_running_{};
+  std::mutex frame_lock_;
+
+  /**
+   * @brief 保留模式下是否已经绘制过第一帧
+   */
+  bool retained_ready_{false};
+
+  /**
+   * @brief 保留模式下本帧的损坏区域，只在渲染线程访问
+   */
+  DamageRegion damage_{};
+
+  /**
+   * @brief 由 invalidate 报告、尚未渲染的损坏区域
+   */
+  DamageRegion pending_damage_{};
+  std::mutex damage_lock_;
+
+  /**
+   * @brief 裁剪区域栈，栈底为整个屏幕，栈顶为当前的裁剪区域
+   */
+  std::vector<Geometry::Rectangle<std::int32_t>> clips_{};
+
+  /**
+   * @brief 录制目标，不为空时绘制调用被录制而不光栅化
+   */
+  Graphics::DisplayList* recording_{nullptr};
+
+  /**
+   * @brief 离屏渲染目标
+   */
+  struct Target {
+    std::span<std::uint8_t> data;
+    std::int32_t width;
+    std::int32_t pages;
+    Geometry::Point<std::int32_t> origin;
+  };
+
+  /**
+   * @brief 离屏渲染目标栈，为空时绘制到 Buffer
+   */
+  std::vector<Target> targets_{};
+
+  /**
+   * @brief 离屏位图缓存，默认大小为 SSDUI_BITMAP_CACHE_SIZE
+   */
+  Graphics::BitmapCache bitmap_cache_{};
+
+  static Graphics::Rotation _rotation(const Config& config) {
+    if constexpr (requires { config.rotation; }) {
+      return config.rotation;
+    } else {
+      return Graphics::Rotation::None;
+    }
+  }
+
+  /**
+   * @brief 配置能否创建帧缓冲：StaticBuffer 的尺寸固定且存储只有一份
+   */
+  static bool _accepts(const Config& config) {
+    if constexpr (requires { typename Pl::Buffer; }) {
+      return Buffer::fits(config.width, config.height) && !Buffer::in_use();
+    } else {
+      return true;
+    }
+  }
+
+  static Buffer _buffer(const Config& config) {
+    if constexpr (requires { typename Pl::Buffer; }) {
+      return Buffer{};
+    } else {
+      return Buffer(config.width, config.height / 8);
+    }
+  }
+
+  /**
+   * @brief 逻辑坐标的区域在 Buffer 中覆盖的区域
+   */
+  [[nodiscard]] Geometry::Rectangle<std::int32_t> _to_buffer(
+      const Geometry::Rectangle<std::int32_t>& region) const {
+    return Graphics::rotate(region, rotation_, buffer_.width(),
+                            buffer_.height() * 8);
+  }
+
+  std::vector<Geometry::Rectangle<std::int32_t>> _render_retained(
+      Node<Pl>* root) {
+    if (!retained_ready_) {
+      {
+        std::lock_guard<std::mutex> lock(damage_lock_);
+        pending_damage_.clear();
+      }
+      buffer_.clear();
+      root->paint_all(this);
+      // 屏幕内容未知，第一帧整屏发送
+      buffer_.invalidate();
+      retained_ready_ = true;
+      return buffer_.dirty_regions();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(damage_lock_);
+      damage_ = pending_damage_;
+      pending_damage_.clear();
+    }
+    for (const auto& region : damage_) {
+      root->mark_damaged(region);
+    }
+    root->collect(this, damage_);
+
+    for (const auto& region : damage_) {
+      buffer_.clear(_to_buffer(region));
+    }
+    for (const auto& region : damage_) {
+      push_clip(region);
+      // 复制一份，离屏渲染会向裁剪栈压入新的区域
+      auto area = clip();
+      root->repaint(this, area);
+      pop_clip();
+    }
+
+    if (rotation_ == Graphics::Rotation::None) {
+      return buffer_.dirty_regions(damage_.rects());
+    }
+    std::vector<Geometry::Rectangle<std::int32_t>> areas{};
+    areas.reserve(damage_.size());
+    for (const auto& region : damage_) {
+      areas.push_back(_to_buffer(region));
+    }
+    return buffer_.dirty_regions(areas);
+  }
+
   Context(std::unique_ptr<Renderer> renderer, Config config,
           std::unique_ptr<BaseComponent<Pl>> root)
       : renderer_(std::move(renderer)),
         config_(std::move(config)),
         root_(std::move(root)),
-        // TODO(dessera): 页大小应该由Buffer自己管理
         // TODO(dessera): Buffer应当是渲染器的一部分
-        buffer_(config.width, config.height / 8) {}
+        buffer_(_buffer(config)),
+        rotation_(_rotation(config)),
+        clips_{{{{0, 0},
+                 rotation_ == Graphics::Rotation::None
+                     ? Geometry::Point<std::int32_t>{config.width,
+                                                     config.height}
+                     : Geometry::Point<std::int32_t>{config.height,
+                                                     config.width}}}} {}
 
  public:
   ~Context() = default;
@@ -116,6 +333,284 @@ class Context {
   void enable_event_manager() { event_manager_.enable(this); }
 
   Store& store() { return store_; }
+
+  /**
+   * @brief 获取调度器
+   *
+   * @return Scheduler<Pl>&
+   */
+  Scheduler<Pl>& scheduler() { return scheduler_; }
+
+  void enable_scheduler() { scheduler_.enable(this); }
+
+  /**
+   * @brief 获取延迟追踪器
+   *
+   * @return LatencyTracer&
+   */
+  LatencyTracer& tracer() { return tracer_; }
+
+  /**
+   * @brief 开始录制事件与帧，传入 nullptr 停止录制，可在任意线程调用
+   *        停止录制时会等待正在写入的帧完成，返回后即可销毁录制器
+   *
+   * @param recorder 录制器，需要在录制期间保持有效
+   */
+  void record(Recorder<Pl>* recorder) {
+    std::lock_guard<std::mutex> lock(record_lock_);
+    recorder_ = recorder;
+    if (recorder == nullptr) {
+      event_manager_.set_observer(nullptr);
+      return;
+    }
+    // 以时间轮的刻度为起点，回放时定时器与录制时在相同的刻度到期
+    recorder->start(scheduler_.tick_now());
+    event_manager_.set_observer(
+        [recorder](const EventPayload<Pl>& event, bool internal) {
+          recorder->record_event(event, internal);
+        });
+  }
+
+  /**
+   * @brief 获取当前的裁剪区域
+   *
+   * @return const Geometry::Rectangle<std::int32_t>&
+   */
+  [[nodiscard]] const Geometry::Rectangle<std::int32_t>& clip() const {
+    return clips_.back();
+  }
+
+  /**
+   * @brief 压入裁剪区域，实际生效的是它与当前裁剪区域的交集
+   *        必须与 pop_clip 成对调用，可以使用 ClipScope
+   *
+   * @param region 区域
+   */
+  void push_clip(const Geometry::Rectangle<std::int32_t>& region) {
+    clips_.push_back(region.intersection(clips_.back()));
+    if (recording_ != nullptr) {
+      recording_->push_clip(region);
+    }
+  }
+
+  /**
+   * @brief 弹出裁剪区域，不会弹出栈底的屏幕区域
+   */
+  void pop_clip() {
+    if (clips_.size() > 1) {
+      clips_.pop_back();
+      if (recording_ != nullptr) {
+        recording_->pop_clip();
+      }
+    }
+  }
+
+  /**
+   * @brief 获取以当前裁剪区域绘制下一帧的表面，图元应当通过它绘制
+   *
+   * @return Graphics::Surface
+   */
+  Graphics::Surface surface() {
+    if (recording_ != nullptr) {
+      // 录制时不裁剪，裁剪区域的变化已记录在列表中
+      return {buffer_.next(),
+              buffer_.width(),
+              buffer_.height(),
+              clips_.front(),
+              recording_,
+              {0, 0},
+              rotation_};
+    }
+    if (!targets_.empty()) {
+      const auto& target = targets_.back();
+      return {target.data, target.width, target.pages,
+              clip(),      nullptr,      target.origin};
+    }
+    return {buffer_.next(),
+            buffer_.width(),
+            buffer_.height(),
+            clip(),
+            nullptr,
+            {0, 0},
+            rotation_};
+  }
+
+  /**
+   * @brief 获取逻辑坐标相对于 Buffer 的旋转
+   */
+  [[nodiscard]] Graphics::Rotation rotation() const { return rotation_; }
+
+  /**
+   * @brief 压入离屏渲染目标，此后的绘制落在目标上，直到 pop_target
+   *        目标与 Buffer 的页格式相同，使用与屏幕相同的绘制坐标
+   *
+   * @param data 页格式的像素数据，大小为 width * pages
+   * @param width 宽度
+   * @param pages 页数
+   * @param origin 目标左上角在绘制坐标系中的位置
+   * @param clip 目标内的裁剪区域，与外层的裁剪区域无关
+   */
+  void push_target(std::span<std::uint8_t> data, std::int32_t width,
+                   std::int32_t pages, Geometry::Point<std::int32_t> origin,
+                   const Geometry::Rectangle<std::int32_t>& clip) {
+    targets_.push_back(Target{data, width, pages, origin});
+    clips_.push_back(clip.intersection({origin, {width, pages * 8}}));
+  }
+
+  void pop_target() {
+    if (!targets_.empty()) {
+      targets_.pop_back();
+      clips_.pop_back();
+    }
+  }
+
+  /**
+   * @brief 获取离屏位图缓存，可通过 configure 设置大小
+   *
+   * @return Graphics::BitmapCache&
+   */
+  Graphics::BitmapCache& bitmap_cache() { return bitmap_cache_; }
+
+  /**
+   * @brief 开始把绘制调用录制到显示列表，此后 surface() 返回录制用的表面
+   *
+   * @param list 显示列表，录制结束前需要保持有效
+   */
+  void begin_recording(Graphics::DisplayList* list) { recording_ = list; }
+
+  void end_recording() { recording_ = nullptr; }
+
+  [[nodiscard]] bool recording() const { return recording_ != nullptr; }
+
+  /**
+   * @brief 报告一块需要重绘的区域，可在任意线程调用，仅在保留模式下有效
+   *        适用于节点只有一小部分发生变化的情况，区域内相交的节点都会重绘
+   *
+   * @param region 区域
+   */
+  void invalidate(Geometry::Rectangle<std::int32_t> region) {
+    std::lock_guard<std::mutex> lock(damage_lock_);
+    pending_damage_.add(region);
+  }
+
+  /**
+   * @brief 获取本帧的损坏区域，仅在保留模式下渲染时有效
+   *
+   * @return const DamageRegion&
+   */
+  [[nodiscard]] const DamageRegion& damage() const { return damage_; }
+
+  /**
+   * @brief 渲染一帧，并与上一帧比较得到需要发送的区域
+   *        保留模式下只重绘并比较损坏区域
+   *
+   * @return std::vector<Geometry::Rectangle<std::int32_t>>
+   */
+  std::vector<Geometry::Rectangle<std::int32_t>> render() {
+    tracer_.frame_begin();
+    frame_time_ = scheduler_.now();
+    std::vector<Geometry::Rectangle<std::int32_t>> regions{};
+    if (auto* node = root_->as_node(); node != nullptr) {
+      regions = _render_retained(node);
+    } else {
+      root_->operator()(this);
+      regions = buffer_.dirty_regions();
+    }
+    tracer_.frame_rendered();
+
+    {
+      std::lock_guard<std::mutex> lock(record_lock_);
+      if (recorder_ != nullptr) {
+        recorder_->record_frame(buffer_, regions, frame_time_);
+      }
+    }
+    return regions;
+  }
+
+  /**
+   * @brief 一帧发送完成后调用，交换缓冲并唤醒等待下一帧的组件
+   *        保留模式下下一帧沿用当前内容，不清空
+   */
+  void present() {
+    if (root_->as_node() != nullptr) {
+      buffer_.sync();
+    } else {
+      buffer_.swap();
+      buffer_.clear();
+    }
+    notify_frame();
+  }
+
+  /**
+   * @brief 注册一次性的帧回调，在下一帧发送完成后由帧计时器线程调用
+   *
+   * @param callback 回调
+   * @param data 回调数据
+   */
+  void on_next_frame(FrameCallback callback, void* data) {
+    std::lock_guard<std::mutex> lock(frame_lock_);
+    frame_callbacks_.emplace_back(callback, data);
+  }
+
+  /**
+   * @brief 通知一帧已发送完成，由帧计时器调用
+   *        帧回调（包括等待下一帧的协程）是内部回调，其中触发的事件不会被
+   *        录制为外部输入；触发时刻为这一帧开始渲染的时刻，回放时与录制一致
+   */
+  void notify_frame() {
+    {
+      std::lock_guard<std::mutex> lock(frame_lock_);
+      frame_callbacks_running_.swap(frame_callbacks_);
+    }
+    {
+      DispatchScope scope(frame_time_);
+      for (auto [callback, data] : frame_callbacks_running_) {
+        callback(data);
+      }
+    }
+    frame_callbacks_running_.clear();
+  }
+
+  /**
+   * @brief 协程等待下一帧，需要包含 ssdui/context/task.hh
+   */
+  NextFrameAwaiter<Pl> next_frame() { return NextFrameAwaiter<Pl>{this}; }
+
+  /**
+   * @brief 协程等待一段时间，需要包含 ssdui/context/task.hh
+   */
+  SleepAwaiter<Pl> sleep_for(Clock::duration duration) {
+    return SleepAwaiter<Pl>{this, duration};
+  }
+
+  /**
+   * @brief 协程等待事件，需要包含 ssdui/context/task.hh
+   */
+  EventAwaiter<Pl> wait_event(typename Pl::Event event) {
+    return EventAwaiter<Pl>{this, event};
+  }
+};
+
+/**
+ * @brief 在作用域内压入裁剪区域
+ */
+template <typename Pl>
+class ClipScope {
+ private:
+  Context<Pl>* ctx_;
+
+ public:
+  ClipScope(Context<Pl>* ctx,
+            const Geometry::Rectangle<std::int32_t>& region)
+      : ctx_(ctx) {
+    ctx_->push_clip(region);
+  }
+  ~ClipScope() { ctx_->pop_clip(); }
+
+  ClipScope(const ClipScope&) = delete;
+  ClipScope(ClipScope&&) = delete;
+  ClipScope& operator=(const ClipScope&) = delete;
+  ClipScope& operator=(ClipScope&&) = delete;
 };
 
 template <typename Pl>
@@ -150,12 +645,18 @@ class Builder {
   }
 
   // TODO(dessera): std::optional -> std::expected
+  /**
+   * @brief 创建上下文，缺少渲染器或根组件、
+   *        Config 与平台的 StaticBuffer 尺寸不符或其存储已被占用时失败
+   */
   std::optional<std::unique_ptr<Context<Pl>>> build() {
-    if (renderer_ == nullptr || root_ == nullptr) {
+    if (renderer_ == nullptr || root_ == nullptr ||
+        !Context<Pl>::_accepts(config_)) {
       return std::nullopt;
     }
-    return std::make_unique<Context<Pl>>(std::move(renderer_),
-                                         std::move(config_), std::move(root_));
+    // 构造函数是私有的，std::make_unique 无法调用
+    return std::unique_ptr<Context<Pl>>(new Context<Pl>(
+        std::move(renderer_), std::move(config_), std::move(root_)));
   }
 };
 }  // namespace SSDUI::Context
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+
+/**
+ *  损坏区域
+ *
+ *  一帧中需要重绘的区域，由固定数量的矩形组成，不分配内存。
+ *  加入的矩形与已有矩形重叠，或合并后不比分开更大时，会合并为一个矩形；
+ *  矩形数量达到上限后，新矩形并入使面积增长最小的那个。
+ *  因此区域内的矩形互不重叠，逐个矩形裁剪绘制时每个像素只绘制一次。
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "ssdui/common/span.hh"
+#include "ssdui/geometry/rectangle.hh"
+
+namespace SSDUI::Context {
+
+class DamageRegion {
+ public:
+  using Rect = Geometry::Rectangle<std::int32_t>;
+
+  static constexpr std::size_t MAX_RECTS = 8;
+
+ private:
+  std::array<Rect, MAX_RECTS> rects_{};
+  std::size_t count_{0};
+
+  void _remove(std::size_t index) { rects_[index] = rects_[--count_]; }
+
+  /**
+   * @brief 找到可以与 rect 合并的矩形，没有时返回 count_
+   */
+  [[nodiscard]] std::size_t _mergeable(const Rect& rect) const {
+    for (std::size_t i = 0; i < count_; i++) {
+      if (rect.intersects(rects_[i]) ||
+          rect.united(rects_[i]).area() <= rect.area() + rects_[i].area()) {
+        return i;
+      }
+    }
+    return count_;
+  }
+
+ public:
+  /**
+   * @brief 加入一个矩形
+   */
+  void add(Rect rect) {
+    if (rect.empty()) {
+      return;
+    }
+
+    // 合并后的矩形可能与其他矩形重叠，需要反复合并
+    for (auto i = _mergeable(rect); i != count_; i = _mergeable(rect)) {
+      rect = rect.united(rects_[i]);
+      _remove(i);
+    }
+
+    if (count_ == MAX_RECTS) {
+      std::size_t best = 0;
+      auto best_growth = rect.united(rects_[0]).area() - rects_[0].area();
+      for (std::size_t i = 1; i < count_; i++) {
+        auto growth = rect.united(rects_[i]).area() - rects_[i].area();
+        if (growth < best_growth) {
+          best = i;
+          best_growth = growth;
+        }
+      }
+      rect = rect.united(rects_[best]);
+      _remove(best);
+      add(rect);
+      return;
+    }
+
+    rects_[count_++] = rect;
+  }
+
+  void add(const DamageRegion& other) {
+    for (const auto& rect : other) {
+      add(rect);
+    }
+  }
+
+  void clear() { count_ = 0; }
+
+  [[nodiscard]] bool empty() const { return count_ == 0; }
+  [[nodiscard]] std::size_t size() const { return count_; }
+
+  [[nodiscard]] const Rect* begin() const { return rects_.data(); }
+  [[nodiscard]] const Rect* end() const { return rects_.data() + count_; }
+
+  [[nodiscard]] std::span<const Rect> rects() const {
+    return {rects_.data(), count_};
+  }
+
+  [[nodiscard]] bool intersects(const Rect& rect) const {
+    for (const auto& region : *this) {
+      if (region.intersects(rect)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief 包含整个区域的最小矩形
+   */
+  [[nodiscard]] Rect bounds() const {
+    Rect bounds({0, 0}, {0, 0});
+    for (const auto& region : *this) {
+      bounds = bounds.united(region);
+    }
+    return bounds;
+  }
+
+  [[nodiscard]] std::int32_t area() const {
+    std::int32_t area = 0;
+    for (const auto& region : *this) {
+      area += region.area();
+    }
+    return area;
+  }
+};
+
+}  // namespace SSDUI::Context
@@ -9,6 +9,7 @@
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
+#include <mutex>
 #include <queue>
 #include <thread>
 #include <type_traits>
@@ -16,6 +17,7 @@
 #include <utility>
 #include <vector>
 
+#include "ssdui/context/clock.hh"
 #include "ssdui/platform/concepts.hh"
 namespace SSDUI::Context {
 
@@ -28,6 +30,70 @@ template <typename Pl>
 struct EventPayload {
   typename Pl::Event type;
   std::any data;
+
+  /**
+   * @brief 事件的触发时刻，用于延迟追踪
+   */
+  TimePoint timestamp{};
+};
+
+/**
+ * @brief 标记当前线程正在执行框架内部回调（事件监听器、定时器）
+ *        期间触发的事件继承外层的触发时刻，并被视为内部事件
+ */
+class DispatchScope {
+  friend class ExternalScope;
+
+ private:
+  static inline thread_local int depth_{0};
+  static inline thread_local TimePoint origin_{};
+
+  TimePoint saved_origin_;
+
+ public:
+  explicit DispatchScope(TimePoint origin) : saved_origin_(origin_) {
+    ++depth_;
+    origin_ = origin;
+  }
+  ~DispatchScope() {
+    --depth_;
+    origin_ = saved_origin_;
+  }
+
+  DispatchScope(const DispatchScope&) = delete;
+  DispatchScope(DispatchScope&&) = delete;
+  DispatchScope& operator=(const DispatchScope&) = delete;
+  DispatchScope& operator=(DispatchScope&&) = delete;
+
+  /**
+   * @brief 当前线程是否处于内部回调中
+   */
+  static bool active() { return depth_ > 0; }
+
+  /**
+   * @brief 外层回调的触发时刻，不在内部回调中时返回当前时间
+   */
+  static TimePoint origin() { return active() ? origin_ : Clock::now(); }
+};
+
+/**
+ * @brief 在内部回调中转发外部输入（例如输入管理器在帧回调中识别出的手势）
+ *        作用域内触发的事件视为外部事件，录制后在回放中重新注入
+ */
+class ExternalScope {
+ private:
+  int saved_depth_;
+
+ public:
+  ExternalScope() : saved_depth_(DispatchScope::depth_) {
+    DispatchScope::depth_ = 0;
+  }
+  ~ExternalScope() { DispatchScope::depth_ = saved_depth_; }
+
+  ExternalScope(const ExternalScope&) = delete;
+  ExternalScope(ExternalScope&&) = delete;
+  ExternalScope& operator=(const ExternalScope&) = delete;
+  ExternalScope& operator=(ExternalScope&&) = delete;
 };
 
 template <typename Pl>
@@ -43,23 +109,53 @@ class EventManager {
       std::vector<std::function<void(Context<Pl>*, const std::any&)>>>
       listeners_{};
 
+  /**
+   * @brief 一次性监听器，触发一次后自动移除
+   */
+  std::unordered_map<
+      typename Pl::Event,
+      std::vector<std::function<void(Context<Pl>*, const std::any&)>>>
+      once_listeners_{};
+
   std::queue<EventPayload<Pl>> event_queue_{};
   std::thread event_thread_;
   std::mutex lock_;
   std::condition_variable event_cv_;
 
-  void _event_loop(Context<Pl>* ctx) {
-    while (true) {
-      std::unique_lock<std::mutex> lock(lock_);
-      event_cv_.wait(lock, [this] { return !event_queue_.empty(); });
+  /**
+   * @brief 触发事件时的观察者，用于录制
+   */
+  std::function<void(const EventPayload<Pl>&, bool)> observer_{};
 
-      auto event = event_queue_.front();
-      event_queue_.pop();
-      lock.unlock();
+  void _dispatch(Context<Pl>* ctx, const EventPayload<Pl>& event,
+                 std::unique_lock<std::mutex>& lock) {
+    std::vector<std::function<void(Context<Pl>*, const std::any&)>> once{};
+    once.swap(once_listeners_[event.type]);
+    lock.unlock();
 
+    auto dispatched = Clock::now();
+    {
+      DispatchScope scope(event.timestamp);
       for (const auto& listener : listeners_[event.type]) {
         listener(ctx, event.data);
       }
+      for (const auto& listener : once) {
+        listener(ctx, event.data);
+      }
+    }
+    ctx->tracer().event_dispatched(event.timestamp, dispatched, Clock::now());
+
+    lock.lock();
+  }
+
+  void _event_loop(Context<Pl>* ctx) {
+    std::unique_lock<std::mutex> lock(lock_);
+    while (true) {
+      event_cv_.wait(lock, [this] { return !event_queue_.empty(); });
+
+      auto event = std::move(event_queue_.front());
+      event_queue_.pop();
+      _dispatch(ctx, event, lock);
     }
   }
 
@@ -98,24 +194,76 @@ class EventManager {
   }
 
   /**
-   * @brief 触发事件
+   * @brief 注册一次性事件监听器，可在任意线程调用
    *
    * @param event 事件
+   * @param listener 监听器
    */
-  void trigger_event(Event event) {
+  void register_once(
+      Event event,
+      std::function<void(Context<Pl>*, const std::any&)> listener) {
     std::lock_guard<std::mutex> lock(lock_);
-    // event_queue_.push(event);
-    // event_cv_.notify_one();
-    event_queue_.push(EventPayload<Pl>{.type = event, .data = std::any{}});
-    event_cv_.notify_one();
+    once_listeners_[event].push_back(std::move(listener));
   }
 
+  /**
+   * @brief 触发事件
+   *
+   * @param event 事件
+   */
+  void trigger_event(Event event) { trigger_event(event, std::any{}); }
+
   void trigger_event(Event event, const std::any& data) {
+    trigger_event(event, data, DispatchScope::origin());
+  }
+
+  /**
+   * @brief 触发事件，并指定触发时刻（例如输入中断记录的时刻）
+   *
+   * @param event 事件
+   * @param data 事件数据
+   * @param timestamp 触发时刻
+   */
+  void trigger_event(Event event, const std::any& data, TimePoint timestamp) {
     std::lock_guard<std::mutex> lock(lock_);
-    event_queue_.push(EventPayload<Pl>{.type = event, .data = data});
+    event_queue_.push(EventPayload<Pl>{
+        .type = event,
+        .data = data,
+        .timestamp = timestamp,
+    });
+    if (observer_) {
+      observer_(event_queue_.back(), DispatchScope::active());
+    }
     event_cv_.notify_one();
   }
 
+  /**
+   * @brief 在当前线程同步分发所有排队的事件，用于未启动事件线程的场景（如回放）
+   *
+   * @return std::size_t 分发的事件数
+   */
+  std::size_t dispatch_pending(Context<Pl>* ctx) {
+    std::unique_lock<std::mutex> lock(lock_);
+    std::size_t count = 0;
+    while (!event_queue_.empty()) {
+      auto event = std::move(event_queue_.front());
+      event_queue_.pop();
+      _dispatch(ctx, event, lock);
+      ++count;
+    }
+    return count;
+  }
+
+  /**
+   * @brief 设置触发事件时的观察者，参数为事件以及该事件是否由内部回调触发
+   *        观察者在持有事件队列锁时调用，不得再触发事件
+   */
+  void set_observer(
+      std::function<void(const EventPayload<Pl>&, bool)> observer) {
+    std::lock_guard<std::mutex> lock(lock_);
+    observer_ = std::move(observer);
+  }
+
   /**
    * @brief 启动事件管理器
    */
@@ -0,0 +1,376 @@
+#pragma once
+
+/**
+ *  保留模式组件树
+ *
+ *  每个节点声明自己的包围盒，并持有一个失效标记。
+ *  节点状态变化后调用 invalidate（可在任意线程），下一帧渲染时：
+ *  1. 收集所有失效节点上一次绘制的包围盒与当前包围盒，加入损坏区域；
+ *  2. 清除损坏区域；
+ *  3. 对损坏区域中的每个矩形，以它为裁剪区域，按树的顺序重绘与它相交的节点。
+ *  没有变化的区域保留在帧缓冲中，不再每帧清空重绘。
+ *
+ *  开启缓存的节点在失效时把 draw 录制为显示列表，列表与上一次相同时
+ *  不产生损坏区域；与损坏区域相交需要重绘时直接重放列表，不再调用 draw。
+ *  缓存只适用于画面完全由自身状态决定、且变化时都会 invalidate 的节点。
+ *
+ *  位图缓存的节点把整棵子树渲染到 Context::bitmap_cache 中的离屏位图上，
+ *  子树没有变化时重绘只需把位图复制到帧缓冲。适用于绘制开销大、很少变化的子树。
+ *  子树必须画在节点的包围盒之内；子树中用 Context::invalidate 报告的区域
+ *  与包围盒相交时，位图同样需要重新渲染。缓存空间不足时退回普通绘制。
+ *
+ *  节点只负责绘制自己（draw），子节点由树遍历负责。
+ *  只有一小部分发生变化的节点可以用 Context::invalidate 只报告变化的部分。
+ *  树结构（add_child、remove_child）与包围盒（set_bounds）只能在挂载时或
+ *  帧回调中修改。
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "ssdui/context/component.hh"
+#include "ssdui/context/damage.hh"
+#include "ssdui/common/span.hh"
+#include "ssdui/geometry/rectangle.hh"
+#include "ssdui/graphics/bitmap.hh"
+#include "ssdui/graphics/display_list.hh"
+#include "ssdui/platform/concepts.hh"
+
+namespace SSDUI::Context {
+
+/**
+ * @brief 节点的缓存方式
+ */
+enum class Cache : std::uint8_t {
+  None,
+  /**
+   * @brief 缓存 draw 的显示列表
+   */
+  List,
+  /**
+   * @brief 缓存整棵子树渲染后的位图
+   */
+  Bitmap,
+};
+
+template <typename Pl>
+class Node : public BaseComponent<Pl> {
+ public:
+  using Rect = Geometry::Rectangle<std::int32_t>;
+
+ private:
+  /**
+   * @brief 当前包围盒
+   */
+  Rect bounds_;
+
+  /**
+   * @brief 上一次绘制时的包围盒，为空表示尚未绘制
+   */
+  Rect painted_{};
+
+  std::atomic<bool> dirty_{true};
+
+  Node* parent_{nullptr};
+  std::vector<Node*> children_{};
+
+  /**
+   * @brief 被移除的子节点留下的区域，下一帧清除
+   */
+  DamageRegion released_{};
+
+  Cache cache_{Cache::None};
+
+  /**
+   * @brief 上一次录制的显示列表，以及录制新列表用的缓冲
+   */
+  Graphics::DisplayList list_{};
+  Graphics::DisplayList scratch_{};
+  std::uint32_t hash_{0};
+
+  /**
+   * @brief 子树变化后位图需要重新渲染
+   *        初始为 true，缓存中同一地址遗留的旧位图不会被误用
+   */
+  bool bitmap_stale_{true};
+
+  /**
+   * @brief 录制一次 draw，返回画面是否与上一次录制不同
+   */
+  bool _record(Context<Pl>* ctx) {
+    scratch_.clear();
+    ctx->begin_recording(&scratch_);
+    draw(ctx);
+    ctx->end_recording();
+
+    auto hash = scratch_.hash();
+    bool changed = hash != hash_ || !(scratch_ == list_);
+    list_.swap(scratch_);
+    hash_ = hash;
+    return changed;
+  }
+
+  void _draw(Context<Pl>* ctx) {
+    if (cache_ == Cache::List) {
+      list_.replay(ctx->surface());
+    } else {
+      draw(ctx);
+    }
+  }
+
+ public:
+  explicit Node(Rect bounds = {}) : bounds_(bounds) {}
+  ~Node() override {
+    if (parent_ != nullptr) {
+      parent_->remove_child(this);
+    }
+    for (auto* child : children_) {
+      child->parent_ = nullptr;
+    }
+  }
+
+  Node(const Node&) = delete;
+  Node(Node&&) = delete;
+  Node& operator=(const Node&) = delete;
+  Node& operator=(Node&&) = delete;
+
+  /**
+   * @brief 绘制节点自身，不包括子节点
+   */
+  virtual void draw(Context<Pl>* ctx) = 0;
+
+  /**
+   * @brief 立即模式下绘制整棵子树，用于挂载在非保留组件之下的情况
+   */
+  void operator()(Context<Pl>* ctx) override {
+    draw(ctx);
+    for (auto* child : children_) {
+      (*child)(ctx);
+    }
+  }
+
+  void on_mount(Context<Pl>* ctx) override {
+    for (auto* child : children_) {
+      child->on_mount(ctx);
+    }
+  }
+
+  Node* as_node() override { return this; }
+
+  /**
+   * @brief 标记节点需要重绘，可在任意线程调用
+   */
+  void invalidate() { dirty_.store(true, std::memory_order_release); }
+
+  /**
+   * @brief 修改包围盒，旧的包围盒会在下一帧被清除
+   *        包围盒在渲染时读取，只能在渲染线程（挂载时或帧回调中）调用；
+   *        在事件回调中修改时，用 Context::on_next_frame 推迟到帧回调
+   */
+  void set_bounds(Rect bounds) {
+    bounds_ = bounds;
+    invalidate();
+  }
+
+  [[nodiscard]] const Rect& bounds() const { return bounds_; }
+
+  [[nodiscard]] bool dirty() const {
+    return dirty_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief 设置缓存方式，需要在挂载前设置
+   */
+  void set_cache(Cache cache) {
+    cache_ = cache;
+    list_.clear();
+    hash_ = 0;
+    bitmap_stale_ = true;
+    invalidate();
+  }
+
+  [[nodiscard]] Cache cache() const { return cache_; }
+
+  /**
+   * @brief 添加子节点，不转移所有权
+   */
+  void add_child(Node* child) {
+    if (child->parent_ != nullptr) {
+      child->parent_->remove_child(child);
+    }
+    child->parent_ = this;
+    child->invalidate();
+    children_.push_back(child);
+  }
+
+  /**
+   * @brief 移除子节点，子树上一次绘制的区域会在下一帧被清除
+   */
+  void remove_child(Node* child) {
+    auto it = std::find(children_.begin(), children_.end(), child);
+    if (it == children_.end()) {
+      return;
+    }
+    child->_release(released_);
+    child->parent_ = nullptr;
+    children_.erase(it);
+  }
+
+  [[nodiscard]] const std::vector<Node*>& children() const {
+    return children_;
+  }
+
+  /**
+   * @brief 收集子树中的损坏区域，并清除失效标记
+   *
+   * @param ctx 上下文
+   * @param damage 损坏区域
+   * @return bool 子树中是否有节点产生了损坏区域
+   */
+  bool collect(Context<Pl>* ctx, DamageRegion& damage) {
+    bool changed = !released_.rects().empty();
+    damage.add(released_);
+    released_.clear();
+
+    if (dirty_.exchange(false, std::memory_order_acq_rel)) {
+      // 缓存的节点只有画面或位置真正变化时才产生损坏区域
+      bool redraw = cache_ == Cache::List ? _record(ctx) : true;
+      if (redraw || painted_ != bounds_) {
+        damage.add(painted_);
+        damage.add(bounds_);
+        painted_ = bounds_;
+        changed = true;
+      }
+    }
+    for (auto* child : children_) {
+      changed = child->collect(ctx, damage) || changed;
+    }
+    if (changed && cache_ == Cache::Bitmap) {
+      bitmap_stale_ = true;
+    }
+    return changed;
+  }
+
+  /**
+   * @brief 由 Context::invalidate 报告的区域与位图缓存的节点相交时，
+   *        位图中的内容已经过期，需要重新渲染
+   *
+   * @param region 报告的区域
+   */
+  void mark_damaged(const Rect& region) {
+    if (cache_ == Cache::Bitmap) {
+      // 子树不超出包围盒，不相交时子树中也没有需要标记的节点
+      if (!bounds_.intersects(region)) {
+        return;
+      }
+      bitmap_stale_ = true;
+    }
+    for (auto* child : children_) {
+      child->mark_damaged(region);
+    }
+  }
+
+  /**
+   * @brief 重绘子树中与区域相交的节点，调用前应当已把裁剪区域设为 region
+   *
+   * @param ctx 上下文
+   * @param region 已清除的区域
+   */
+  void repaint(Context<Pl>* ctx, const Rect& region) {
+    if (cache_ == Cache::Bitmap) {
+      // 子树不超出包围盒，不相交时整棵子树都不需要重绘
+      if (!bounds_.intersects(region) || _blit(ctx)) {
+        return;
+      }
+    }
+    if (bounds_.intersects(region)) {
+      _draw(ctx);
+    }
+    for (auto* child : children_) {
+      child->repaint(ctx, region);
+    }
+  }
+
+  /**
+   * @brief 无条件绘制整棵子树，用于第一帧
+   */
+  void paint_all(Context<Pl>* ctx) {
+    if (cache_ == Cache::Bitmap) {
+      bitmap_stale_ = true;
+      if (_blit(ctx)) {
+        _settle(ctx);
+        return;
+      }
+    }
+    dirty_.store(false, std::memory_order_release);
+    released_.clear();
+    if (cache_ == Cache::List) {
+      _record(ctx);
+    }
+    _draw(ctx);
+    painted_ = bounds_;
+    for (auto* child : children_) {
+      child->paint_all(ctx);
+    }
+  }
+
+ private:
+  /**
+   * @brief 把子树的位图复制到当前表面，位图过期时先重新渲染
+   *
+   * @return bool 缓存空间不足时返回 false，由调用者按普通方式绘制
+   */
+  bool _blit(Context<Pl>* ctx) {
+    // 位图的上边界对齐到页，渲染与复制都按整字节进行
+    auto top = bounds_.origin.y & ~7;
+    auto width = bounds_.size.x;
+    auto pages = (bounds_.origin.y + bounds_.size.y - top + 7) / 8;
+    auto* slot = ctx->bitmap_cache().acquire(this, width, pages);
+    if (slot == nullptr) {
+      return false;
+    }
+
+    Geometry::Point<std::int32_t> origin{bounds_.origin.x, top};
+    if (!slot->valid || bitmap_stale_) {
+      std::span<std::uint8_t> data{slot->data,
+                                   static_cast<std::size_t>(width * pages)};
+      std::fill(data.begin(), data.end(), std::uint8_t{0});
+      ctx->push_target(data, width, pages, origin, bounds_);
+      (*this)(ctx);
+      ctx->pop_target();
+      slot->valid = true;
+      bitmap_stale_ = false;
+    }
+    ctx->surface().blit(Graphics::Bitmap{slot->data, width, pages}, origin);
+    return true;
+  }
+
+  /**
+   * @brief 标记子树已经绘制，用于位图代替子树完成了第一帧
+   */
+  void _settle(Context<Pl>* ctx) {
+    dirty_.store(false, std::memory_order_release);
+    released_.clear();
+    if (cache_ == Cache::List) {
+      _record(ctx);
+    }
+    painted_ = bounds_;
+    for (auto* child : children_) {
+      child->_settle(ctx);
+    }
+  }
+
+  void _release(DamageRegion& damage) {
+    damage.add(painted_);
+    painted_ = {};
+    damage.add(released_);
+    released_.clear();
+    for (auto* child : children_) {
+      child->_release(damage);
+    }
+  }
+};
+
+}  // namespace SSDUI::Context
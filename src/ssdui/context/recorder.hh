@@ -0,0 +1,300 @@
+#pragma once
+
+/**
+ *  事件录制与回放
+ *
+ *  录制：记录每一次 trigger_event（类型、数据、时刻、是否为内部事件）
+ *  以及每一帧的结果（帧缓冲哈希、发送字节数，可选完整帧缓冲）。
+ *
+ *  回放：在无界面的渲染流程上按录制的时刻重新注入外部事件、推进调度器
+ *  并渲染帧，逐帧比较帧缓冲与发送字节数。内部事件（监听器、定时器中触发的事件）
+ *  会在回放中自然重现，因此不会重复注入。
+ *
+ *  回放要求应用本身是确定的（例如不使用 std::random_device 作为种子），
+ *  且不启动事件线程与调度器工作线程。
+ *
+ *  录制结果可以用 TraceCodec（trace_codec.hh）编码后从设备取回，在主机上回放。
+ */
+
+#include <algorithm>
+#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ssdui/common/span.hh"
+#include "ssdui/context/buffer.hh"
+#include "ssdui/context/clock.hh"
+#include "ssdui/context/event.hh"
+#include "ssdui/geometry/rectangle.hh"
+#include "ssdui/platform/concepts.hh"
+
+namespace SSDUI::Context {
+
+template <typename Pl>
+  requires Platform::IsPlatform<Pl>
+class Context;
+
+template <typename Pl>
+  requires Platform::IsPlatform<Pl>
+struct EventRecord {
+  typename Pl::Event type;
+  std::any data;
+
+  /**
+   * @brief 调用 trigger_event 的时刻，相对于录制开始
+   */
+  Clock::duration at;
+
+  /**
+   * @brief 事件携带的触发时刻，相对于录制开始
+   *        可能早于 at，例如输入中断记录的时刻
+   */
+  Clock::duration origin;
+
+  /**
+   * @brief 是否由内部回调触发，回放时不重新注入
+   */
+  bool internal;
+};
+
+struct FrameRecord {
+  Clock::duration at;
+  std::uint32_t hash;
+  std::uint32_t transfer_bytes;
+
+  /**
+   * @brief 完整帧缓冲，仅在录制时开启 keep_frames 才保存
+   */
+  std::vector<std::uint8_t> buffer;
+};
+
+template <typename Pl>
+  requires Platform::IsPlatform<Pl>
+struct Trace {
+  std::vector<EventRecord<Pl>> events;
+  std::vector<FrameRecord> frames;
+};
+
+/**
+ * @brief 帧缓冲的 FNV-1a 哈希
+ */
+inline std::uint32_t hash_frame(std::span<std::uint8_t> frame) {
+  std::uint32_t hash = 2166136261U;
+  for (auto byte : frame) {
+    hash = (hash ^ byte) * 16777619U;
+  }
+  return hash;
+}
+
+/**
+ * @brief 一帧需要发送的数据字节数
+ */
+inline std::uint32_t transfer_bytes(
+    const std::vector<Geometry::Rectangle<std::int32_t>>& regions) {
+  std::uint32_t bytes = 0;
+  for (const auto& region : regions) {
+    bytes += static_cast<std::uint32_t>(region.size.x * region.size.y);
+  }
+  return bytes;
+}
+
+template <typename Pl>
+  requires Platform::IsPlatform<Pl>
+class Recorder {
+ private:
+  Trace<Pl> trace_{};
+  TimePoint start_{};
+  bool keep_frames_;
+  std::mutex lock_;
+
+ public:
+  /**
+   * @param keep_frames 是否保存完整帧缓冲（每帧占用一个帧缓冲大小的内存）
+   */
+  explicit Recorder(bool keep_frames = false) : keep_frames_(keep_frames) {}
+
+  Recorder(const Recorder&) = delete;
+  Recorder(Recorder&&) = delete;
+  Recorder& operator=(const Recorder&) = delete;
+  Recorder& operator=(Recorder&&) = delete;
+
+  /**
+   * @brief 开始录制，清空之前的记录
+   */
+  void start(TimePoint now = Clock::now()) {
+    std::lock_guard<std::mutex> lock(lock_);
+    trace_ = {};
+    start_ = now;
+  }
+
+  void record_event(const EventPayload<Pl>& event, bool internal,
+                    TimePoint now = Clock::now()) {
+    std::lock_guard<std::mutex> lock(lock_);
+    trace_.events.push_back(EventRecord<Pl>{
+        .type = event.type,
+        .data = event.data,
+        .at = now - start_,
+        .origin = event.timestamp - start_,
+        .internal = internal,
+    });
+  }
+
+  template <typename Bu>
+  void record_frame(const Bu& buffer,
+                    const std::vector<Geometry::Rectangle<std::int32_t>>&
+                        regions,
+                    TimePoint now = Clock::now()) {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto frame = buffer.next();
+    trace_.frames.push_back(FrameRecord{
+        .at = now - start_,
+        .hash = hash_frame(frame),
+        .transfer_bytes = transfer_bytes(regions),
+        .buffer = keep_frames_
+                      ? std::vector<std::uint8_t>(frame.begin(), frame.end())
+                      : std::vector<std::uint8_t>{},
+    });
+  }
+
+  /**
+   * @brief 取出录制结果
+   */
+  Trace<Pl> take() {
+    std::lock_guard<std::mutex> lock(lock_);
+    return std::exchange(trace_, {});
+  }
+};
+
+/**
+ * @brief 回放结果
+ */
+struct ReplayReport {
+  std::size_t frames{0};
+  std::size_t mismatched_frames{0};
+
+  /**
+   * @brief 第一个帧缓冲不一致的帧序号，全部一致时为 frames
+   */
+  std::size_t first_mismatch{0};
+
+  std::uint64_t recorded_bytes{0};
+  std::uint64_t replayed_bytes{0};
+
+  /**
+   * @brief 回放中每一帧的发送字节数
+   */
+  std::vector<std::uint32_t> frame_bytes{};
+
+  /**
+   * @brief 回放实际耗时
+   */
+  Clock::duration elapsed{};
+};
+
+template <typename Pl>
+  requires Platform::IsPlatform<Pl>
+class Replayer {
+ public:
+  enum class Mode : std::uint8_t {
+    /**
+     * @brief 以最快速度回放，时间完全虚拟
+     */
+    FullSpeed,
+    /**
+     * @brief 按录制时的节奏回放
+     */
+    RealTime,
+  };
+
+ private:
+  const Trace<Pl>* trace_;
+
+  static void _advance(Context<Pl>* ctx, TimePoint now) {
+    ctx->scheduler().advance(ctx, now);
+    ctx->event_manager().dispatch_pending(ctx);
+  }
+
+ public:
+  explicit Replayer(const Trace<Pl>* trace) : trace_(trace) {}
+
+  /**
+   * @brief 在上下文上回放，上下文应当刚刚创建且已挂载根组件
+   *
+   * @param ctx 上下文，不得启动事件线程与调度器工作线程
+   * @param mode 回放模式
+   * @return ReplayReport
+   */
+  ReplayReport run(Context<Pl>* ctx, Mode mode = Mode::FullSpeed) {
+    ReplayReport report{};
+    const auto& events = trace_->events;
+    const auto& frames = trace_->frames;
+
+    auto real_start = Clock::now();
+    // 虚拟时间从时间轮的一个刻度开始，与录制的起点对齐；
+    // 此后调度器只由录制的时刻驱动，定时器在与录制时相同的刻度到期
+    auto base = ctx->scheduler().tick_now();
+    ctx->scheduler().drive(base);
+
+    std::size_t event_index = 0;
+    std::size_t frame_index = 0;
+    report.first_mismatch = frames.size();
+
+    while (frame_index < frames.size()) {
+      // 跳过内部事件，它们会在回放中重新产生
+      while (event_index < events.size() && events[event_index].internal) {
+        ++event_index;
+      }
+
+      bool is_event = event_index < events.size() &&
+                      events[event_index].at <= frames[frame_index].at;
+      auto at = is_event ? events[event_index].at : frames[frame_index].at;
+
+      if (mode == Mode::RealTime) {
+        std::this_thread::sleep_until(real_start + at);
+      }
+      _advance(ctx, base + at);
+
+      if (is_event) {
+        const auto& event = events[event_index++];
+        ctx->event_manager().trigger_event(event.type, event.data,
+                                           base + event.origin);
+        ctx->event_manager().dispatch_pending(ctx);
+        continue;
+      }
+
+      const auto& recorded = frames[frame_index];
+      auto regions = ctx->render();
+      auto frame = ctx->buffer().next();
+      auto bytes = transfer_bytes(regions);
+
+      bool matched = recorded.buffer.empty()
+                         ? hash_frame(frame) == recorded.hash
+                         : std::equal(frame.begin(), frame.end(),
+                                      recorded.buffer.begin(),
+                                      recorded.buffer.end());
+      if (!matched) {
+        ++report.mismatched_frames;
+        if (report.first_mismatch == frames.size()) {
+          report.first_mismatch = frame_index;
+        }
+      }
+
+      report.recorded_bytes += recorded.transfer_bytes;
+      report.replayed_bytes += bytes;
+      report.frame_bytes.push_back(bytes);
+
+      ctx->present();
+      ++frame_index;
+    }
+
+    report.frames = frames.size();
+    report.elapsed = Clock::now() - real_start;
+    return report;
+  }
+};
+
+}  // namespace SSDUI::Context
@@ -0,0 +1,443 @@
+#pragma once
+
+/**
+ *  调度器
+ *
+ *  调度器为组件提供一次性与周期性的定时回调，所有定时器共享同一个工作线程
+ *  （或由帧计时器线程驱动），避免每个组件各自持有线程。
+ *
+ *  内部实现为分层时间轮：共 LEVELS 层，每层 SLOTS 个槽位，
+ *  插入、删除均为 O(1)，每个定时器仅占用一个节点。
+ */
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ssdui/context/clock.hh"
+#include "ssdui/context/event.hh"
+#include "ssdui/platform/concepts.hh"
+namespace SSDUI::Context {
+
+template <typename Pl>
+  requires Platform::IsPlatform<Pl>
+class Context;
+
+template <typename Pl>
+  requires Platform::IsPlatform<Pl>
+class Scheduler {
+ public:
+  using Platform = Pl;
+  using Callback = std::function<void(Context<Pl>*)>;
+
+  /**
+   * @brief 定时器句柄，高 16 位为代数，低 16 位为节点索引
+   */
+  using TimerId = std::uint32_t;
+
+  static constexpr TimerId INVALID_TIMER = 0;
+
+  /**
+   * @brief 时间轮的最小刻度
+   */
+  static constexpr auto TICK = std::chrono::milliseconds(1);
+
+  static constexpr std::uint32_t WHEEL_BITS = 6;
+  static constexpr std::uint32_t SLOTS = 1U << WHEEL_BITS;
+  static constexpr std::uint32_t SLOT_MASK = SLOTS - 1;
+  static constexpr std::uint32_t LEVELS = 4;
+
+  /**
+   * @brief 可表示的最大延时（刻度数），超出的延时会被截断
+   */
+  static constexpr std::uint32_t MAX_TICKS = (1U << (WHEEL_BITS * LEVELS)) - 1;
+
+  /**
+   * @brief 同时存在的定时器节点数上限，节点索引为 int16_t 且 -1 表示空
+   */
+  static constexpr std::size_t MAX_TIMERS = INT16_MAX;
+
+ private:
+  static constexpr std::int16_t NIL = -1;
+
+  struct Timer {
+    Callback callback{};
+    std::uint32_t expires{0};
+    std::uint32_t period{0};
+    std::int16_t next{NIL};
+    std::uint16_t generation{1};
+    bool armed{false};
+  };
+
+  std::vector<Timer> timers_{};
+  std::int16_t free_{NIL};
+  std::array<std::array<std::int16_t, SLOTS>, LEVELS> wheel_{};
+
+  /**
+   * @brief 当前刻度，以及与之对应的时间点
+   */
+  std::uint32_t current_{0};
+  TimePoint current_time_{Clock::now()};
+
+  /**
+   * @brief 仍挂在时间轮上的节点数（包括已取消、尚未回收的节点）
+   */
+  std::size_t pending_{0};
+
+  /**
+   * @brief 外部时钟（回放）：当前时刻只由 advance 给出，不读取 Clock
+   */
+  bool driven_{false};
+  TimePoint driven_now_{};
+
+  std::thread worker_thread_;
+  std::mutex lock_;
+  std::condition_variable worker_cv_;
+  bool running_{false};
+
+  TimePoint _now() const { return driven_ ? driven_now_ : Clock::now(); }
+
+  static TimerId _make_id(std::int16_t index, std::uint16_t generation) {
+    return (static_cast<TimerId>(generation) << 16U) |
+           static_cast<TimerId>(index);
+  }
+
+  static std::uint32_t _to_ticks(Clock::duration duration) {
+    if (duration <= Clock::duration::zero()) {
+      return 0;
+    }
+    // 向上取整，保证定时器不会提前触发
+    auto ticks = (duration + TICK - Clock::duration(1)) / TICK;
+    return ticks > MAX_TICKS ? MAX_TICKS : static_cast<std::uint32_t>(ticks);
+  }
+
+  /**
+   * @brief 取得一个空闲节点，节点数达到 MAX_TIMERS 时返回 NIL
+   */
+  std::int16_t _allocate() {
+    if (free_ != NIL) {
+      auto index = free_;
+      free_ = timers_[index].next;
+      timers_[index].next = NIL;
+      return index;
+    }
+    if (timers_.size() >= MAX_TIMERS) {
+      return NIL;
+    }
+    timers_.emplace_back();
+    return static_cast<std::int16_t>(timers_.size() - 1);
+  }
+
+  void _release(std::int16_t index) {
+    auto& timer = timers_[index];
+    timer.callback = nullptr;
+    timer.armed = false;
+    // 代数 0 保留给 INVALID_TIMER
+    timer.generation = timer.generation == UINT16_MAX
+                           ? std::uint16_t{1}
+                           : static_cast<std::uint16_t>(timer.generation + 1);
+    timer.next = free_;
+    free_ = index;
+  }
+
+  void _insert(std::int16_t index) {
+    auto& timer = timers_[index];
+    auto delta = timer.expires - current_;
+
+    std::uint32_t level = 0;
+    while (level + 1 < LEVELS && delta >= (1U << (WHEEL_BITS * (level + 1)))) {
+      ++level;
+    }
+
+    auto& head =
+        wheel_[level][(timer.expires >> (WHEEL_BITS * level)) & SLOT_MASK];
+    timer.next = head;
+    head = index;
+    ++pending_;
+  }
+
+  std::int16_t _take(std::uint32_t level, std::uint32_t slot) {
+    auto head = wheel_[level][slot];
+    wheel_[level][slot] = NIL;
+    for (auto index = head; index != NIL; index = timers_[index].next) {
+      --pending_;
+    }
+    return head;
+  }
+
+  /**
+   * @brief 时间轮前进一个刻度，调用者持有锁
+   */
+  void _step(Context<Pl>* ctx, std::unique_lock<std::mutex>& lock) {
+    ++current_;
+    current_time_ += TICK;
+
+    // 低层转满一圈时，把高层对应槽位的定时器重新分配到低层
+    for (std::uint32_t level = 1; level < LEVELS; ++level) {
+      if ((current_ & ((1U << (WHEEL_BITS * level)) - 1)) != 0) {
+        break;
+      }
+      auto index =
+          _take(level, (current_ >> (WHEEL_BITS * level)) & SLOT_MASK);
+      while (index != NIL) {
+        auto next = timers_[index].next;
+        if (timers_[index].armed) {
+          _insert(index);
+        } else {
+          _release(index);
+        }
+        index = next;
+      }
+    }
+
+    auto index = _take(0, current_ & SLOT_MASK);
+    while (index != NIL) {
+      auto next = timers_[index].next;
+      if (!timers_[index].armed) {
+        _release(index);
+        index = next;
+        continue;
+      }
+
+      // 回调执行期间释放锁，允许回调内注册或取消定时器
+      auto callback = std::move(timers_[index].callback);
+      lock.unlock();
+      {
+        DispatchScope scope(current_time_);
+        callback(ctx);
+      }
+      lock.lock();
+
+      auto& timer = timers_[index];
+      if (timer.armed && timer.period != 0) {
+        timer.callback = std::move(callback);
+        timer.expires = current_ + timer.period;
+        _insert(index);
+      } else {
+        _release(index);
+      }
+      index = next;
+    }
+  }
+
+  /**
+   * @brief 距离下一次需要处理的刻度数，0 表示时间轮为空
+   */
+  std::uint32_t _next_step() const {
+    if (pending_ == 0) {
+      return 0;
+    }
+    std::uint32_t steps = 1;
+    for (auto tick = current_ + 1;; ++tick, ++steps) {
+      if (wheel_[0][tick & SLOT_MASK] != NIL || (tick & SLOT_MASK) == 0) {
+        return steps;
+      }
+    }
+  }
+
+  void _advance(Context<Pl>* ctx, TimePoint now,
+                std::unique_lock<std::mutex>& lock) {
+    if (driven_ && now > driven_now_) {
+      driven_now_ = now;
+    }
+    if (now <= current_time_) {
+      return;
+    }
+    auto steps = static_cast<std::uint32_t>((now - current_time_) / TICK);
+    if (pending_ == 0) {
+      // 时间轮为空时直接跳过空闲时段
+      current_ += steps;
+      current_time_ += steps * TICK;
+      return;
+    }
+    auto target = current_ + steps;
+    // 回调执行期间其他线程可能已推进时间轮，用有符号差值判断
+    while (static_cast<std::int32_t>(target - current_) > 0) {
+      _step(ctx, lock);
+    }
+  }
+
+  void _worker_loop(Context<Pl>* ctx) {
+    std::unique_lock<std::mutex> lock(lock_);
+    while (running_) {
+      auto steps = _next_step();
+      if (steps == 0) {
+        worker_cv_.wait(lock);
+      } else {
+        worker_cv_.wait_until(lock, current_time_ + steps * TICK);
+      }
+      if (running_) {
+        _advance(ctx, _now(), lock);
+      }
+    }
+  }
+
+ public:
+  Scheduler() {
+    for (auto& level : wheel_) {
+      level.fill(NIL);
+    }
+  }
+
+  ~Scheduler() {
+    {
+      std::lock_guard<std::mutex> lock(lock_);
+      running_ = false;
+    }
+    worker_cv_.notify_one();
+    if (worker_thread_.joinable()) {
+      worker_thread_.join();
+    }
+  }
+
+  // 因为线程的存在，所以禁止拷贝和移动
+  Scheduler(const Scheduler&) = delete;
+  Scheduler(Scheduler&&) = delete;
+  Scheduler& operator=(const Scheduler&) = delete;
+  Scheduler& operator=(Scheduler&&) = delete;
+
+  /**
+   * @brief 注册定时器
+   *
+   * @param delay 首次触发的延时
+   * @param period 触发周期，为 0 时只触发一次
+   * @param callback 回调
+   * @return TimerId 定时器句柄，用于取消；
+   *         定时器数量达到 MAX_TIMERS 时不注册并返回 INVALID_TIMER
+   */
+  TimerId schedule(Clock::duration delay, Clock::duration period,
+                   Callback callback) {
+    std::unique_lock<std::mutex> lock(lock_);
+
+    // 延时从调用时刻算起，而非当前刻度；在内部回调中从触发它的时刻算起，
+    // 与回调实际执行的时机无关，录制与回放得到相同的到期刻度
+    auto now = DispatchScope::active() ? DispatchScope::origin() : _now();
+    auto lag = now - current_time_;
+    auto ticks = _to_ticks(delay + (lag > Clock::duration::zero()
+                                        ? lag
+                                        : Clock::duration::zero()));
+
+    auto index = _allocate();
+    if (index == NIL) {
+      return INVALID_TIMER;
+    }
+    auto& timer = timers_[index];
+    timer.callback = std::move(callback);
+    timer.expires = current_ + (ticks == 0 ? 1 : ticks);
+    timer.period = _to_ticks(period);
+    timer.armed = true;
+    auto id = _make_id(index, timer.generation);
+    _insert(index);
+
+    lock.unlock();
+    worker_cv_.notify_one();
+    return id;
+  }
+
+  /**
+   * @brief 注册一次性定时器
+   */
+  TimerId schedule_once(Clock::duration delay, Callback callback) {
+    return schedule(delay, Clock::duration::zero(), std::move(callback));
+  }
+
+  /**
+   * @brief 注册周期性定时器，首次触发在一个周期之后
+   *        周期不大于 0 时不注册并返回 INVALID_TIMER，
+   *        一次性定时器用 schedule_once
+   */
+  TimerId schedule_periodic(Clock::duration period, Callback callback) {
+    if (period <= Clock::duration::zero()) {
+      return INVALID_TIMER;
+    }
+    return schedule(period, period, std::move(callback));
+  }
+
+  /**
+   * @brief 取消定时器，节点会在时间轮转到它时回收
+   *
+   * @return bool 定时器是否仍处于激活状态
+   */
+  bool cancel(TimerId id) {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto index = static_cast<std::int16_t>(id & 0xFFFFU);
+    auto generation = static_cast<std::uint16_t>(id >> 16U);
+    if (id == INVALID_TIMER || index < 0 ||
+        index >= static_cast<int>(timers_.size()) ||
+        timers_[index].generation != generation || !timers_[index].armed) {
+      return false;
+    }
+    timers_[index].armed = false;
+    return true;
+  }
+
+  /**
+   * @brief 推进时间轮并执行到期的回调，可由帧计时器线程每帧调用
+   *
+   * @param ctx 上下文
+   * @param now 当前时间
+   */
+  void advance(Context<Pl>* ctx, TimePoint now = Clock::now()) {
+    std::unique_lock<std::mutex> lock(lock_);
+    _advance(ctx, now, lock);
+  }
+
+  /**
+   * @brief 调度器的当前时刻，由外部时钟驱动时为最近一次 advance 的时刻
+   */
+  TimePoint now() {
+    std::lock_guard<std::mutex> lock(lock_);
+    return _now();
+  }
+
+  /**
+   * @brief 对齐到时间轮刻度的当前时刻
+   */
+  TimePoint tick_now() {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto now = _now();
+    if (now <= current_time_) {
+      return current_time_;
+    }
+    return current_time_ + ((now - current_time_) / TICK) * TICK;
+  }
+
+  /**
+   * @brief 改由外部时钟驱动（回放），此后当前时刻只由 advance 给出
+   *        不得同时启动工作线程
+   *
+   * @param now 外部时钟的起点
+   */
+  void drive(TimePoint now) {
+    std::lock_guard<std::mutex> lock(lock_);
+    driven_ = true;
+    driven_now_ = now;
+  }
+
+  /**
+   * @brief 工作线程是否已启动
+   */
+  bool enabled() {
+    std::lock_guard<std::mutex> lock(lock_);
+    return running_;
+  }
+
+  /**
+   * @brief 启动共享工作线程，工作线程只在有定时器到期时唤醒
+   */
+  void enable(Context<Pl>* ctx) {
+    {
+      std::lock_guard<std::mutex> lock(lock_);
+      running_ = true;
+    }
+    worker_thread_ = std::thread([this, ctx]() { _worker_loop(ctx); });
+  }
+};
+
+}  // namespace SSDUI::Context
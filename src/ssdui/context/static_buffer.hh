@@ -0,0 +1,158 @@
+#pragma once
+
+/**
+ *  编译期确定尺寸的帧缓冲
+ *
+ *  与 Buffer 接口相同，两帧保存在每个 StaticBuffer 类型独有的静态数组中：
+ *  帧缓冲在链接时就分配在 .bss 中，不从堆分配，开机时不会产生碎片；
+ *  Context 仍由 Builder 在堆上创建，其中只保存帧的下标。
+ *  宽度与页数是模板参数，下标换算与按页的循环次数都是常量，
+ *  清除、复制与比较可以被编译器展开或向量化。
+ *
+ *  每个 StaticBuffer<W, H, Tag> 类型只有一份存储，同一时刻只能存在一个对象，
+ *  对象不可复制；多个相同尺寸的屏幕用不同的 Tag 区分。
+ *
+ *  平台类型中声明 using Buffer = StaticBuffer<W, H> 后，
+ *  Context 使用它代替 Buffer。Builder 在 Config 的 width、height 与 W、H
+ *  不一致，或这一类型的存储已被占用时构建失败。
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "ssdui/common/span.hh"
+#include "ssdui/context/buffer.hh"
+#include "ssdui/geometry/rectangle.hh"
+
+namespace SSDUI::Context {
+
+/**
+ * @tparam Width 宽度（像素）
+ * @tparam Height 高度（像素），需要为 8 的倍数
+ * @tparam Tag 区分相同尺寸的多个屏幕
+ */
+template <std::int16_t Width, std::int16_t Height, typename Tag = void>
+class StaticBuffer {
+  static_assert(Width > 0 && Height > 0 && Height % 8 == 0,
+                "StaticBuffer: height must be a positive multiple of 8");
+
+ public:
+  static constexpr std::int16_t PAGES = Height / 8;
+  static constexpr std::size_t SIZE = static_cast<std::size_t>(Width) * PAGES;
+
+ private:
+  using Columns = std::integral_constant<std::int32_t, Width>;
+  using Pages = std::integral_constant<std::int32_t, PAGES>;
+
+  static inline std::array<std::array<std::uint8_t, SIZE>, 2> frames_{};
+  static inline bool in_use_{false};
+
+  /**
+   * @brief 下一帧在 frames_ 中的位置，交换时只改变这个下标
+   */
+  std::uint8_t next_{1};
+
+  [[nodiscard]] std::uint8_t* _prev() { return frames_[next_ ^ 1U].data(); }
+  [[nodiscard]] std::uint8_t* _next() { return frames_[next_].data(); }
+  [[nodiscard]] const std::uint8_t* _prev() const {
+    return frames_[next_ ^ 1U].data();
+  }
+  [[nodiscard]] const std::uint8_t* _next() const {
+    return frames_[next_].data();
+  }
+
+ public:
+  /**
+   * @brief 占用这一类型的存储，初始状态与 Buffer 相同：上一帧全暗，下一帧全亮
+   */
+  StaticBuffer() {
+    in_use_ = true;
+    frames_[0].fill(0);
+    frames_[1].fill(0xFF);
+  }
+
+  ~StaticBuffer() { in_use_ = false; }
+
+  StaticBuffer(const StaticBuffer&) = delete;
+  StaticBuffer(StaticBuffer&&) = delete;
+  StaticBuffer& operator=(const StaticBuffer&) = delete;
+  StaticBuffer& operator=(StaticBuffer&&) = delete;
+
+  /**
+   * @brief 这一类型的存储是否已被某个对象占用
+   */
+  [[nodiscard]] static bool in_use() { return in_use_; }
+
+  /**
+   * @brief 配置的尺寸是否与模板参数一致
+   */
+  [[nodiscard]] static constexpr bool fits(std::int32_t width,
+                                           std::int32_t height) {
+    return width == Width && height == Height;
+  }
+
+  [[nodiscard]] std::span<std::uint8_t> prev() const {
+    return {const_cast<std::uint8_t*>(_prev()), SIZE};
+  }
+  [[nodiscard]] std::span<std::uint8_t> next() const {
+    return {const_cast<std::uint8_t*>(_next()), SIZE};
+  }
+
+  [[nodiscard]] static constexpr std::int16_t width() { return Width; }
+  [[nodiscard]] static constexpr std::int16_t height() { return PAGES; }
+
+  void swap() noexcept { next_ ^= 1U; }
+  void clear() noexcept { frames_[next_].fill(0); }
+
+  /**
+   * @brief 清除下一帧中的一个区域，区域以像素为单位，超出屏幕的部分被忽略
+   *
+   * @param region 区域
+   */
+  void clear(const Geometry::Rectangle<std::int32_t>& region) noexcept {
+    Detail::clear_region(_next(), Columns{}, Pages{}, region);
+  }
+
+  /**
+   * @brief 把下一帧复制到上一帧，下一帧保留当前内容
+   */
+  void sync() noexcept { frames_[next_ ^ 1U] = frames_[next_]; }
+
+  /**
+   * @brief 使上一帧与下一帧的每个字节都不同，下一次比较时发送整个屏幕
+   */
+  void invalidate() noexcept {
+    auto* prev = _prev();
+    const auto* next = _next();
+    for (std::size_t i = 0; i < SIZE; i++) {
+      prev[i] = static_cast<std::uint8_t>(~next[i]);
+    }
+  }
+
+  void set(std::int16_t x, std::int16_t y, std::uint8_t value) {
+    _next()[x + y * Width] = value;
+  }
+
+  void mixin(std::int16_t x, std::int16_t y, std::uint8_t value) {
+    _next()[x + y * Width] |= value;
+  }
+
+  /**
+   * @brief 比较前后两帧，得到需要发送的区域，与 Buffer::dirty_regions 相同
+   */
+  [[nodiscard]] std::vector<Geometry::Rectangle<std::int32_t>> dirty_regions()
+      const {
+    return Detail::dirty_regions(_prev(), _next(), Columns{}, Pages{});
+  }
+
+  [[nodiscard]] std::vector<Geometry::Rectangle<std::int32_t>> dirty_regions(
+      std::span<const Geometry::Rectangle<std::int32_t>> areas) const {
+    return Detail::dirty_regions(_prev(), _next(), Columns{}, Pages{}, areas);
+  }
+};
+
+}  // namespace SSDUI::Context
@@ -0,0 +1,362 @@
+#pragma once
+
+/**
+ *  协程任务
+ *
+ *  组件可以把顺序执行的行为（动画、多步协议、游戏循环）写成无栈协程，
+ *  在以下位置挂起，并由上下文的各个服务恢复：
+ *  - co_await ctx->next_frame()  : 下一帧发送完成后，由帧计时器线程恢复
+ *  - co_await ctx->sleep_for(d)  : 延时到期后，由调度器恢复
+ *  - co_await ctx->wait_event(e) : 事件触发后，由事件线程恢复，返回事件数据
+ *
+ *  协程帧从固定大小的内存池分配，不使用堆。
+ *  内存池大小可以通过 SSDUI_TASK_FRAME_SIZE 与 SSDUI_TASK_POOL_SIZE 调整。
+ *
+ *  挂起时各个服务持有的只是一张“票”（帧的序号与挂起的次数），
+ *  恢复前先向内存池核对：任务在挂起期间被销毁或重新赋值后，票随之作废，
+ *  迟到的定时器、事件与帧回调不会再恢复已经释放的协程帧。
+ *
+ *  需要编译器支持 C++20 协程（GCC >= 10 并启用 -fcoroutines）。
+ *  本头文件不在 ssdui/context.hh 中，不支持协程的工具链只要不包含它即可。
+ */
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "task.hh requires C++20 coroutines (GCC >= 10 with -fcoroutines)"
+#endif
+
+#include <any>
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <utility>
+
+#include "ssdui/context/clock.hh"
+#include "ssdui/context/context.hh"
+#include "ssdui/platform/concepts.hh"
+
+#ifndef SSDUI_TASK_FRAME_SIZE
+#define SSDUI_TASK_FRAME_SIZE 256
+#endif
+
+#ifndef SSDUI_TASK_POOL_SIZE
+#define SSDUI_TASK_POOL_SIZE 8
+#endif
+
+namespace SSDUI::Context {
+
+/**
+ * @brief 协程帧内存池，所有任务共享
+ */
+class TaskFramePool {
+ public:
+  static constexpr std::size_t FRAME_SIZE = SSDUI_TASK_FRAME_SIZE;
+  static constexpr std::size_t POOL_SIZE = SSDUI_TASK_POOL_SIZE;
+
+ private:
+  struct alignas(std::max_align_t) Frame {
+    std::array<std::byte, FRAME_SIZE> storage;
+  };
+
+  static inline std::array<Frame, POOL_SIZE> frames_{};
+  static inline std::array<bool, POOL_SIZE> used_{};
+
+  /**
+   * @brief 票的低 INDEX_BITS 位为帧序号加 1，其余位为该帧挂起的次数
+   */
+  static constexpr unsigned INDEX_BITS = 8;
+  static_assert(POOL_SIZE < (1U << INDEX_BITS) - 1,
+                "SSDUI_TASK_POOL_SIZE is too large");
+
+  /**
+   * @brief 每个帧当前有效的挂起次数，挂起、恢复与释放时递增；
+   *        以及挂起的协程帧地址，用于只携带一个指针的帧回调
+   */
+  static inline std::array<std::uintptr_t, POOL_SIZE> counts_{};
+  static inline std::array<void*, POOL_SIZE> addresses_{};
+  static inline std::mutex lock_{};
+
+  /**
+   * @brief 协程帧地址所在的帧序号，不在内存池中时返回 POOL_SIZE
+   */
+  static std::size_t _index(const void* address) noexcept {
+    const auto* byte = static_cast<const std::byte*>(address);
+    for (std::size_t i = 0; i < POOL_SIZE; ++i) {
+      const auto* storage = frames_[i].storage.data();
+      if (byte >= storage && byte < storage + FRAME_SIZE) {
+        return i;
+      }
+    }
+    return POOL_SIZE;
+  }
+
+  static std::uintptr_t _ticket(std::size_t index) noexcept {
+    return (counts_[index] << INDEX_BITS) | (index + 1);
+  }
+
+ public:
+  /**
+   * @brief 挂起票，大小与指针相同，可以直接作为帧回调的参数；0 表示无效
+   */
+  using Ticket = std::uintptr_t;
+
+  /**
+   * @brief 协程挂起时取得一张票，之前发出的票全部作废
+   *        协程帧不在内存池中（不是 Task）时返回 0
+   */
+  static Ticket suspend(void* address) noexcept {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto index = _index(address);
+    if (index == POOL_SIZE) {
+      return 0;
+    }
+    ++counts_[index];
+    addresses_[index] = address;
+    return _ticket(index);
+  }
+
+  /**
+   * @brief 服务准备恢复协程时核对票，票有效时作废它并返回协程帧地址
+   *        同一张票只能成功一次，重复或迟到的回调得到 nullptr
+   */
+  static void* claim(Ticket ticket) noexcept {
+    auto index = static_cast<std::size_t>(ticket & ((1U << INDEX_BITS) - 1));
+    if (index == 0 || index > POOL_SIZE) {
+      return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(lock_);
+    if (!used_[--index] || _ticket(index) != ticket) {
+      return nullptr;
+    }
+    ++counts_[index];
+    return addresses_[index];
+  }
+
+  /**
+   * @brief 作废协程帧尚未使用的票，任务销毁前调用
+   */
+  static void cancel(const void* address) noexcept {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto index = _index(address);
+    if (index != POOL_SIZE) {
+      ++counts_[index];
+    }
+  }
+
+  /**
+   * @brief 分配协程帧，帧过大或内存池耗尽时返回 nullptr
+   */
+  static void* allocate(std::size_t size) noexcept {
+    if (size > FRAME_SIZE) {
+      return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(lock_);
+    for (std::size_t i = 0; i < POOL_SIZE; ++i) {
+      if (!used_[i]) {
+        used_[i] = true;
+        return frames_[i].storage.data();
+      }
+    }
+    return nullptr;
+  }
+
+  static void deallocate(void* ptr) noexcept {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto* frame = static_cast<Frame*>(ptr);
+    auto index = static_cast<std::size_t>(frame - frames_.data());
+    used_[index] = false;
+    ++counts_[index];
+  }
+
+  /**
+   * @brief 当前已分配的协程帧数量
+   */
+  static std::size_t used() noexcept {
+    std::lock_guard<std::mutex> lock(lock_);
+    std::size_t count = 0;
+    for (auto used : used_) {
+      count += used ? 1 : 0;
+    }
+    return count;
+  }
+};
+
+/**
+ * @brief 协程任务，创建后处于挂起状态，调用 start() 开始执行
+ *        任务对象持有协程帧；挂起等待期间销毁或重新赋值会取消等待，
+ *        但不得与协程的执行（在恢复它的线程上）同时进行
+ */
+class Task {
+ public:
+  struct promise_type {
+    Task get_return_object() {
+      return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    /**
+     * @brief 内存池耗尽时返回空任务，而不是抛出异常
+     */
+    static Task get_return_object_on_allocation_failure() { return Task{}; }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+
+    static void* operator new(std::size_t size) noexcept {
+      return TaskFramePool::allocate(size);
+    }
+    static void operator delete(void* ptr) noexcept {
+      TaskFramePool::deallocate(ptr);
+    }
+  };
+
+ private:
+  std::coroutine_handle<promise_type> handle_{};
+
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+  void _destroy() {
+    if (handle_) {
+      // 先作废挂起时发出的票，再释放协程帧
+      TaskFramePool::cancel(handle_.address());
+      handle_.destroy();
+      handle_ = {};
+    }
+  }
+
+ public:
+  Task() = default;
+
+  ~Task() { _destroy(); }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      _destroy();
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+
+  /**
+   * @brief 任务是否持有协程帧（分配失败时为 false）
+   */
+  [[nodiscard]] bool valid() const { return static_cast<bool>(handle_); }
+
+  [[nodiscard]] bool done() const { return !handle_ || handle_.done(); }
+
+  /**
+   * @brief 开始执行，直到第一次挂起
+   */
+  void start() {
+    if (handle_ && !handle_.done()) {
+      handle_.resume();
+    }
+  }
+};
+
+/**
+ * @brief 等待下一帧
+ */
+template <typename Pl>
+class NextFrameAwaiter {
+  Context<Pl>* ctx_;
+
+  /**
+   * @brief 帧回调的参数为挂起票，票已作废时协程帧可能已经释放，不再恢复
+   */
+  static void _resume(void* data) {
+    auto* address =
+        TaskFramePool::claim(reinterpret_cast<TaskFramePool::Ticket>(data));
+    if (address != nullptr) {
+      std::coroutine_handle<>::from_address(address).resume();
+    }
+  }
+
+  /**
+   * @brief 不是 Task 的协程没有票，参数直接为协程帧地址
+   */
+  static void _resume_handle(void* address) {
+    std::coroutine_handle<>::from_address(address).resume();
+  }
+
+ public:
+  explicit NextFrameAwaiter(Context<Pl>* ctx) : ctx_(ctx) {}
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> handle) {
+    auto ticket = TaskFramePool::suspend(handle.address());
+    if (ticket == 0) {
+      ctx_->on_next_frame(&NextFrameAwaiter::_resume_handle, handle.address());
+    } else {
+      ctx_->on_next_frame(&NextFrameAwaiter::_resume,
+                          reinterpret_cast<void*>(ticket));
+    }
+  }
+  void await_resume() const noexcept {}
+};
+
+/**
+ * @brief 等待一段时间
+ */
+template <typename Pl>
+class SleepAwaiter {
+  Context<Pl>* ctx_;
+  Clock::duration duration_;
+
+ public:
+  SleepAwaiter(Context<Pl>* ctx, Clock::duration duration)
+      : ctx_(ctx), duration_(duration) {}
+
+  bool await_ready() const noexcept {
+    return duration_ <= Clock::duration::zero();
+  }
+  /**
+   * @brief 定时器数量达到上限时不挂起，立即继续执行
+   */
+  bool await_suspend(std::coroutine_handle<> handle) {
+    using Timers = Scheduler<Pl>;
+    auto ticket = TaskFramePool::suspend(handle.address());
+    return ctx_->scheduler().schedule_once(duration_, [handle, ticket](auto*) {
+      if (ticket == 0 || TaskFramePool::claim(ticket) != nullptr) {
+        handle.resume();
+      }
+    }) != Timers::INVALID_TIMER;
+  }
+  void await_resume() const noexcept {}
+};
+
+/**
+ * @brief 等待事件，恢复时返回事件数据
+ */
+template <typename Pl>
+class EventAwaiter {
+  Context<Pl>* ctx_;
+  typename Pl::Event event_;
+  std::any data_{};
+
+ public:
+  EventAwaiter(Context<Pl>* ctx, typename Pl::Event event)
+      : ctx_(ctx), event_(event) {}
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> handle) {
+    auto ticket = TaskFramePool::suspend(handle.address());
+    ctx_->event_manager().register_once(
+        event_, [this, handle, ticket](auto*, const std::any& data) {
+          if (ticket == 0 || TaskFramePool::claim(ticket) != nullptr) {
+            data_ = data;
+            handle.resume();
+          }
+        });
+  }
+  std::any await_resume() { return std::move(data_); }
+};
+
+}  // namespace SSDUI::Context
@@ -0,0 +1,249 @@
+#pragma once
+
+/**
+ *  延迟追踪
+ *
+ *  追踪一个事件从触发到画面可见的完整耗时，分为以下阶段：
+ *  - Queue    : 触发 -> 事件线程开始分发
+ *  - Handle   : 开始分发 -> 所有监听器执行完毕（即 Store 修改完成）
+ *  - Frame    : 监听器执行完毕 -> 下一帧开始渲染（帧率量化）
+ *  - Render   : 开始渲染 -> 渲染与差异计算完成
+ *  - Transfer : 渲染完成 -> 总线发送完成
+ *  - Total    : 触发 -> 总线发送完成
+ *
+ *  只有产生了画面变化的帧才会计入直方图，
+ *  没有引起变化的事件只计数，不计入耗时。
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "ssdui/context/clock.hh"
+
+namespace SSDUI::Context {
+
+/**
+ * @brief 对数分桶的耗时直方图
+ *        第 0 桶为 [0, 256us)，第 i 桶为 [2^(i+7)us, 2^(i+8)us)，最后一桶无上界
+ */
+struct LatencyHistogram {
+  static constexpr std::size_t BUCKETS = 16;
+  static constexpr std::uint32_t FIRST_BUCKET_SHIFT = 8;
+
+  std::array<std::uint32_t, BUCKETS> buckets{};
+  std::uint32_t count{0};
+  Clock::duration total{};
+  Clock::duration max{};
+
+  static std::size_t bucket_of(Clock::duration duration) {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration)
+                  .count();
+    std::size_t bucket = 0;
+    for (auto bound = std::int64_t{1} << FIRST_BUCKET_SHIFT;
+         us >= bound && bucket + 1 < BUCKETS; bound <<= 1) {
+      ++bucket;
+    }
+    return bucket;
+  }
+
+  /**
+   * @brief 第 bucket 桶的上界
+   */
+  static std::chrono::microseconds upper_bound(std::size_t bucket) {
+    return std::chrono::microseconds(std::int64_t{1}
+                                     << (bucket + FIRST_BUCKET_SHIFT));
+  }
+
+  void add(Clock::duration duration) {
+    if (duration < Clock::duration::zero()) {
+      duration = Clock::duration::zero();
+    }
+    ++buckets[bucket_of(duration)];
+    ++count;
+    total += duration;
+    max = duration > max ? duration : max;
+  }
+
+  [[nodiscard]] Clock::duration mean() const {
+    return count == 0 ? Clock::duration::zero() : total / count;
+  }
+
+  /**
+   * @brief 估算分位数，返回所在桶的上界
+   *
+   * @param ratio 分位，例如 0.99
+   */
+  [[nodiscard]] std::chrono::microseconds percentile(double ratio) const {
+    auto target = static_cast<std::uint32_t>(ratio * count);
+    std::uint32_t seen = 0;
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+      seen += buckets[i];
+      if (seen > target) {
+        return upper_bound(i);
+      }
+    }
+    return upper_bound(BUCKETS - 1);
+  }
+};
+
+class LatencyTracer {
+ public:
+  enum class Stage : std::uint8_t {
+    Queue,
+    Handle,
+    Frame,
+    Render,
+    Transfer,
+    Total,
+  };
+
+  static constexpr std::size_t STAGES = 6;
+
+  /**
+   * @brief 同一帧内最多追踪的事件数，超出部分只计数
+   */
+  static constexpr std::size_t MAX_PENDING = 16;
+
+ private:
+  struct Record {
+    TimePoint triggered;
+    TimePoint dispatched;
+    TimePoint handled;
+  };
+
+  std::atomic<bool> enabled_{false};
+  std::mutex lock_;
+
+  std::array<Record, MAX_PENDING> pending_{};
+  std::size_t pending_count_{0};
+  std::array<Record, MAX_PENDING> in_flight_{};
+  std::size_t in_flight_count_{0};
+
+  TimePoint frame_begin_{};
+  TimePoint frame_rendered_{};
+
+  std::array<LatencyHistogram, STAGES> histograms_{};
+  std::uint32_t dropped_{0};
+  std::uint32_t unchanged_{0};
+
+  LatencyHistogram& _histogram(Stage stage) {
+    return histograms_[static_cast<std::size_t>(stage)];
+  }
+
+ public:
+  void enable() { enabled_.store(true, std::memory_order_relaxed); }
+  void disable() { enabled_.store(false, std::memory_order_relaxed); }
+  [[nodiscard]] bool enabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief 事件分发完成，由事件线程调用
+   */
+  void event_dispatched(TimePoint triggered, TimePoint dispatched,
+                        TimePoint handled) {
+    if (!enabled()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(lock_);
+    if (pending_count_ == MAX_PENDING) {
+      ++dropped_;
+      return;
+    }
+    pending_[pending_count_++] = Record{triggered, dispatched, handled};
+  }
+
+  /**
+   * @brief 一帧开始渲染，此前处理完的事件归入这一帧
+   */
+  void frame_begin(TimePoint now = Clock::now()) {
+    if (!enabled()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(lock_);
+    frame_begin_ = now;
+    for (std::size_t i = 0; i < pending_count_; ++i) {
+      if (in_flight_count_ == MAX_PENDING) {
+        ++dropped_;
+        continue;
+      }
+      in_flight_[in_flight_count_++] = pending_[i];
+    }
+    pending_count_ = 0;
+  }
+
+  /**
+   * @brief 一帧渲染与差异计算完成
+   */
+  void frame_rendered(TimePoint now = Clock::now()) {
+    if (!enabled()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(lock_);
+    frame_rendered_ = now;
+  }
+
+  /**
+   * @brief 一帧发送完成
+   *
+   * @param changed 这一帧是否产生了画面变化
+   */
+  void frame_flushed(bool changed, TimePoint now = Clock::now()) {
+    if (!enabled()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(lock_);
+    if (!changed) {
+      unchanged_ += in_flight_count_;
+      in_flight_count_ = 0;
+      return;
+    }
+    for (std::size_t i = 0; i < in_flight_count_; ++i) {
+      const auto& record = in_flight_[i];
+      _histogram(Stage::Queue).add(record.dispatched - record.triggered);
+      _histogram(Stage::Handle).add(record.handled - record.dispatched);
+      _histogram(Stage::Frame).add(frame_begin_ - record.handled);
+      _histogram(Stage::Render).add(frame_rendered_ - frame_begin_);
+      _histogram(Stage::Transfer).add(now - frame_rendered_);
+      _histogram(Stage::Total).add(now - record.triggered);
+    }
+    in_flight_count_ = 0;
+  }
+
+  /**
+   * @brief 获取某一阶段的直方图快照
+   */
+  LatencyHistogram histogram(Stage stage) {
+    std::lock_guard<std::mutex> lock(lock_);
+    return _histogram(stage);
+  }
+
+  /**
+   * @brief 因追踪容量不足而丢弃的事件数
+   */
+  std::uint32_t dropped() {
+    std::lock_guard<std::mutex> lock(lock_);
+    return dropped_;
+  }
+
+  /**
+   * @brief 没有引起画面变化的事件数
+   */
+  std::uint32_t unchanged() {
+    std::lock_guard<std::mutex> lock(lock_);
+    return unchanged_;
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> lock(lock_);
+    histograms_ = {};
+    dropped_ = 0;
+    unchanged_ = 0;
+  }
+};
+
+}  // namespace SSDUI::Context
@@ -0,0 +1,312 @@
+#pragma once
+
+/**
+ *  录制结果的序列化
+ *
+ *  设备上录制的 Trace 编码为字节流（经串口或写入 flash 取回），
+ *  在主机上解码后交给 Replayer 回放。事件数据为 std::any，本身无法序列化，
+ *  需要为携带数据的每种事件登记编解码器：
+ *  - bind<T>(event)：T 为可平凡复制的类型，按字节复制，
+ *    要求两端的布局一致（ESP32 与常见主机均为小端，注意对齐与填充）；
+ *  - bind(event, encode, decode)：自定义编解码，例如把设备上的时间点换算为
+ *    相对录制开始的时长。
+ *  不携带数据的事件无需登记。
+ *
+ *  格式（整数均为小端）：
+ *    "SSDT" 版本(u8)
+ *    事件数(u32)，每个事件：类型(i32) at(i64 ns) origin(i64 ns) 内部(u8)
+ *                          数据长度(u32) 数据
+ *    帧数(u32)，每帧：at(i64 ns) 哈希(u32) 发送字节数(u32)
+ *                     帧缓冲长度(u32) 帧缓冲
+ */
+
+#include <any>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ssdui/common/span.hh"
+#include "ssdui/context/clock.hh"
+#include "ssdui/context/recorder.hh"
+#include "ssdui/platform/concepts.hh"
+
+namespace SSDUI::Context {
+
+namespace Detail {
+
+class TraceWriter {
+ private:
+  std::vector<std::uint8_t>& out_;
+
+ public:
+  explicit TraceWriter(std::vector<std::uint8_t>& out) : out_(out) {}
+
+  void u8(std::uint8_t value) { out_.push_back(value); }
+
+  void u32(std::uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+      out_.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+    }
+  }
+
+  void i64(std::int64_t value) {
+    auto bits = static_cast<std::uint64_t>(value);
+    for (int i = 0; i < 8; i++) {
+      out_.push_back(static_cast<std::uint8_t>(bits >> (i * 8)));
+    }
+  }
+
+  void duration(Clock::duration value) {
+    i64(std::chrono::duration_cast<std::chrono::nanoseconds>(value).count());
+  }
+
+  void bytes(std::span<const std::uint8_t> data) {
+    u32(static_cast<std::uint32_t>(data.size()));
+    out_.insert(out_.end(), data.begin(), data.end());
+  }
+};
+
+/**
+ * @brief 读取越界后 ok() 为 false，此后读出的值均为 0
+ */
+class TraceReader {
+ private:
+  std::span<const std::uint8_t> data_;
+  std::size_t offset_{0};
+  bool ok_{true};
+
+  bool _need(std::size_t size) {
+    if (!ok_ || data_.size() - offset_ < size) {
+      ok_ = false;
+    }
+    return ok_;
+  }
+
+ public:
+  explicit TraceReader(std::span<const std::uint8_t> data) : data_(data) {}
+
+  [[nodiscard]] bool ok() const { return ok_; }
+  [[nodiscard]] bool done() const { return offset_ == data_.size(); }
+
+  std::uint8_t u8() { return _need(1) ? data_[offset_++] : 0; }
+
+  std::uint32_t u32() {
+    if (!_need(4)) {
+      return 0;
+    }
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+      value |= static_cast<std::uint32_t>(data_[offset_++]) << (i * 8);
+    }
+    return value;
+  }
+
+  std::int64_t i64() {
+    if (!_need(8)) {
+      return 0;
+    }
+    std::uint64_t bits = 0;
+    for (int i = 0; i < 8; i++) {
+      bits |= static_cast<std::uint64_t>(data_[offset_++]) << (i * 8);
+    }
+    return static_cast<std::int64_t>(bits);
+  }
+
+  Clock::duration duration() {
+    return std::chrono::duration_cast<Clock::duration>(
+        std::chrono::nanoseconds(i64()));
+  }
+
+  std::span<const std::uint8_t> bytes() {
+    auto size = u32();
+    if (!_need(size)) {
+      return {};
+    }
+    auto data = data_.subspan(offset_, size);
+    offset_ += size;
+    return data;
+  }
+};
+
+}  // namespace Detail
+
+template <typename Pl>
+  requires Platform::IsPlatform<Pl>
+class TraceCodec {
+ public:
+  using Event = typename Pl::Event;
+
+  /**
+   * @brief 把事件数据追加到 out，数据类型不符时返回 false
+   */
+  using Encoder =
+      std::function<bool(const std::any&, std::vector<std::uint8_t>&)>;
+
+  /**
+   * @brief 从字节还原事件数据，数据损坏时返回 std::nullopt
+   */
+  using Decoder =
+      std::function<std::optional<std::any>(std::span<const std::uint8_t>)>;
+
+  static constexpr std::uint8_t VERSION = 1;
+
+ private:
+  struct Codec {
+    Encoder encode;
+    Decoder decode;
+  };
+
+  std::unordered_map<Event, Codec> codecs_{};
+
+ public:
+  /**
+   * @brief 登记事件的自定义编解码器
+   */
+  void bind(Event event, Encoder encode, Decoder decode) {
+    codecs_[event] = Codec{std::move(encode), std::move(decode)};
+  }
+
+  /**
+   * @brief 登记数据为可平凡复制类型 T 的事件，按字节复制
+   */
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void bind(Event event) {
+    bind(
+        event,
+        [](const std::any& data, std::vector<std::uint8_t>& out) {
+          const auto* value = std::any_cast<T>(&data);
+          if (value == nullptr) {
+            return false;
+          }
+          const auto* bytes = reinterpret_cast<const std::uint8_t*>(value);
+          out.insert(out.end(), bytes, bytes + sizeof(T));
+          return true;
+        },
+        [](std::span<const std::uint8_t> bytes) -> std::optional<std::any> {
+          if (bytes.size() != sizeof(T)) {
+            return std::nullopt;
+          }
+          T value;
+          std::memcpy(&value, bytes.data(), sizeof(T));
+          return std::any{value};
+        });
+  }
+
+  /**
+   * @brief 编码录制结果
+   *
+   * @return std::optional<std::vector<std::uint8_t>>
+   *         携带数据的事件没有登记编解码器或类型不符时返回 std::nullopt
+   */
+  [[nodiscard]] std::optional<std::vector<std::uint8_t>> encode(
+      const Trace<Pl>& trace) const {
+    std::vector<std::uint8_t> out{'S', 'S', 'D', 'T'};
+    Detail::TraceWriter writer(out);
+    writer.u8(VERSION);
+
+    std::vector<std::uint8_t> payload{};
+    writer.u32(static_cast<std::uint32_t>(trace.events.size()));
+    for (const auto& event : trace.events) {
+      payload.clear();
+      if (event.data.has_value()) {
+        auto codec = codecs_.find(event.type);
+        if (codec == codecs_.end() ||
+            !codec->second.encode(event.data, payload)) {
+          return std::nullopt;
+        }
+      }
+      writer.u32(static_cast<std::uint32_t>(
+          static_cast<std::int32_t>(event.type)));
+      writer.duration(event.at);
+      writer.duration(event.origin);
+      writer.u8(event.internal ? 1 : 0);
+      writer.bytes(payload);
+    }
+
+    writer.u32(static_cast<std::uint32_t>(trace.frames.size()));
+    for (const auto& frame : trace.frames) {
+      writer.duration(frame.at);
+      writer.u32(frame.hash);
+      writer.u32(frame.transfer_bytes);
+      writer.bytes(frame.buffer);
+    }
+    return out;
+  }
+
+  /**
+   * @brief 解码录制结果
+   *
+   * @return std::optional<Trace<Pl>> 格式错误、版本不符、
+   *         事件数据无法解码时返回 std::nullopt
+   */
+  [[nodiscard]] std::optional<Trace<Pl>> decode(
+      std::span<const std::uint8_t> data) const {
+    if (data.size() < 5 || std::memcmp(data.data(), "SSDT", 4) != 0 ||
+        data[4] != VERSION) {
+      return std::nullopt;
+    }
+    Detail::TraceReader reader(data.subspan(5, data.size() - 5));
+    Trace<Pl> trace{};
+
+    auto events = reader.u32();
+    for (std::uint32_t i = 0; i < events && reader.ok(); i++) {
+      auto type = static_cast<Event>(static_cast<std::int32_t>(reader.u32()));
+      auto at = reader.duration();
+      auto origin = reader.duration();
+      auto internal = reader.u8() != 0;
+      auto payload = reader.bytes();
+      if (!reader.ok()) {
+        return std::nullopt;
+      }
+
+      std::any value{};
+      if (!payload.empty()) {
+        auto codec = codecs_.find(type);
+        if (codec == codecs_.end()) {
+          return std::nullopt;
+        }
+        auto decoded = codec->second.decode(payload);
+        if (!decoded.has_value()) {
+          return std::nullopt;
+        }
+        value = std::move(*decoded);
+      }
+      trace.events.push_back(EventRecord<Pl>{
+          .type = type,
+          .data = std::move(value),
+          .at = at,
+          .origin = origin,
+          .internal = internal,
+      });
+    }
+
+    auto frames = reader.u32();
+    for (std::uint32_t i = 0; i < frames && reader.ok(); i++) {
+      auto at = reader.duration();
+      auto hash = reader.u32();
+      auto bytes = reader.u32();
+      auto buffer = reader.bytes();
+      trace.frames.push_back(FrameRecord{
+          .at = at,
+          .hash = hash,
+          .transfer_bytes = bytes,
+          .buffer = std::vector<std::uint8_t>(buffer.begin(), buffer.end()),
+      });
+    }
+
+    if (!reader.ok() || !reader.done()) {
+      return std::nullopt;
+    }
+    return trace;
+  }
+};
+
+}  // namespace SSDUI::Context
@@ -10,49 +10,49 @@ struct Line {
   Point<T> end;
 
   Line() = default;
-  Line(Point<T> start, Point<T> end) : start(start), end(end) {}
+  constexpr Line(Point<T> start, Point<T> end) : start(start), end(end) {}
 
-  Line operator+(const Point<T>& rhs) const {
+  constexpr Line operator+(const Point<T>& rhs) const {
     return Line(start + rhs, end + rhs);
   }
 
-  Line operator-(const Point<T>& rhs) const {
+  constexpr Line operator-(const Point<T>& rhs) const {
     return Line(start - rhs, end - rhs);
   }
 
-  Line operator*(T rhs) const { return Line(start * rhs, end * rhs); }
+  constexpr Line operator*(T rhs) const { return Line(start * rhs, end * rhs); }
 
-  Line operator/(T rhs) const { return Line(start / rhs, end / rhs); }
+  constexpr Line operator/(T rhs) const { return Line(start / rhs, end / rhs); }
 
-  Line& operator+=(const Point<T>& rhs) {
+  constexpr Line& operator+=(const Point<T>& rhs) {
     start += rhs;
     end += rhs;
     return *this;
   }
 
-  Line& operator-=(const Point<T>& rhs) {
+  constexpr Line& operator-=(const Point<T>& rhs) {
     start -= rhs;
     end -= rhs;
     return *this;
   }
 
-  Line& operator*=(T rhs) {
+  constexpr Line& operator*=(T rhs) {
     start *= rhs;
     end *= rhs;
     return *this;
   }
 
-  Line& operator/=(T rhs) {
+  constexpr Line& operator/=(T rhs) {
     start /= rhs;
     end /= rhs;
     return *this;
   }
 
-  bool operator==(const Line& rhs) const {
+  constexpr bool operator==(const Line& rhs) const {
     return start == rhs.start && end == rhs.end;
   }
 
-  bool operator!=(const Line& rhs) const {
+  constexpr bool operator!=(const Line& rhs) const {
     return start != rhs.start || end != rhs.end;
   }
 };
@@ -10,47 +10,51 @@ struct Point {
   T y;
 
   Point() = default;
-  Point(T x, T y) : x(x), y(y) {}
+  constexpr Point(T x, T y) : x(x), y(y) {}
 
-  Point operator+(const Point& rhs) const {
+  constexpr Point operator+(const Point& rhs) const {
     return Point(x + rhs.x, y + rhs.y);
   }
 
-  Point operator-(const Point& rhs) const {
+  constexpr Point operator-(const Point& rhs) const {
     return Point(x - rhs.x, y - rhs.y);
   }
 
-  Point operator*(T rhs) const { return Point(x * rhs, y * rhs); }
+  constexpr Point operator*(T rhs) const { return Point(x * rhs, y * rhs); }
 
-  Point operator/(T rhs) const { return Point(x / rhs, y / rhs); }
+  constexpr Point operator/(T rhs) const { return Point(x / rhs, y / rhs); }
 
-  Point& operator+=(const Point& rhs) {
+  constexpr Point& operator+=(const Point& rhs) {
     x += rhs.x;
     y += rhs.y;
     return *this;
   }
 
-  Point& operator-=(const Point& rhs) {
+  constexpr Point& operator-=(const Point& rhs) {
     x -= rhs.x;
     y -= rhs.y;
     return *this;
   }
 
-  Point& operator*=(T rhs) {
+  constexpr Point& operator*=(T rhs) {
     x *= rhs;
     y *= rhs;
     return *this;
   }
 
-  Point& operator/=(T rhs) {
+  constexpr Point& operator/=(T rhs) {
     x /= rhs;
     y /= rhs;
     return *this;
   }
 
-  bool operator==(const Point& rhs) const { return x == rhs.x && y == rhs.y; }
+  constexpr bool operator==(const Point& rhs) const {
+    return x == rhs.x && y == rhs.y;
+  }
 
-  bool operator!=(const Point& rhs) const { return x != rhs.x || y != rhs.y; }
+  constexpr bool operator!=(const Point& rhs) const {
+    return x != rhs.x || y != rhs.y;
+  }
 };
 
 }  // namespace SSDUI::Geometry
\ No newline at end of file
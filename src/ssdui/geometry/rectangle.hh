@@ -11,51 +11,117 @@ struct Rectangle {
   Point<T> size;
 
   Rectangle() = default;
-  Rectangle(Point<T> origin, Point<T> size) : origin(origin), size(size) {}
+  constexpr Rectangle(Point<T> origin, Point<T> size)
+      : origin(origin), size(size) {}
 
-  Rectangle operator+(const Point<T>& rhs) const {
+  constexpr Rectangle operator+(const Point<T>& rhs) const {
     return Rectangle(origin + rhs, size);
   }
 
-  Rectangle operator-(const Point<T>& rhs) const {
+  constexpr Rectangle operator-(const Point<T>& rhs) const {
     return Rectangle(origin - rhs, size);
   }
 
-  Rectangle operator*(T rhs) const {
+  constexpr Rectangle operator*(T rhs) const {
     return Rectangle(origin * rhs, size * rhs);
   }
 
-  Rectangle operator/(T rhs) const {
+  constexpr Rectangle operator/(T rhs) const {
     return Rectangle(origin / rhs, size / rhs);
   }
 
-  Rectangle& operator+=(const Point<T>& rhs) {
+  constexpr Rectangle& operator+=(const Point<T>& rhs) {
     origin += rhs;
     return *this;
   }
 
-  Rectangle& operator-=(const Point<T>& rhs) {
+  constexpr Rectangle& operator-=(const Point<T>& rhs) {
     origin -= rhs;
     return *this;
   }
 
-  Rectangle& operator*=(T rhs) {
+  constexpr Rectangle& operator*=(T rhs) {
     origin *= rhs;
     return *this;
   }
 
-  Rectangle& operator/=(T rhs) {
+  constexpr Rectangle& operator/=(T rhs) {
     origin /= rhs;
     return *this;
   }
 
-  bool operator==(const Rectangle& rhs) const {
+  constexpr bool operator==(const Rectangle& rhs) const {
     return origin == rhs.origin && size == rhs.size;
   }
 
-  bool operator!=(const Rectangle& rhs) const {
+  constexpr bool operator!=(const Rectangle& rhs) const {
     return origin != rhs.origin || size != rhs.size;
   }
+
+  /**
+   * @brief 面积是否为零
+   */
+  [[nodiscard]] constexpr bool empty() const {
+    return size.x <= 0 || size.y <= 0;
+  }
+
+  /**
+   * @brief 两个矩形是否有重叠部分
+   */
+  [[nodiscard]] constexpr bool intersects(const Rectangle& rhs) const {
+    return !empty() && !rhs.empty() && origin.x < rhs.origin.x + rhs.size.x &&
+           rhs.origin.x < origin.x + size.x &&
+           origin.y < rhs.origin.y + rhs.size.y &&
+           rhs.origin.y < origin.y + size.y;
+  }
+
+  [[nodiscard]] constexpr bool contains(const Point<T>& point) const {
+    return point.x >= origin.x && point.x < origin.x + size.x &&
+           point.y >= origin.y && point.y < origin.y + size.y;
+  }
+
+  [[nodiscard]] constexpr T area() const {
+    return empty() ? 0 : size.x * size.y;
+  }
+
+  /**
+   * @brief 两个矩形的重叠部分，不重叠时返回空矩形
+   */
+  [[nodiscard]] constexpr Rectangle intersection(const Rectangle& rhs) const {
+    if (!intersects(rhs)) {
+      return Rectangle({0, 0}, {0, 0});
+    }
+    T left = origin.x > rhs.origin.x ? origin.x : rhs.origin.x;
+    T top = origin.y > rhs.origin.y ? origin.y : rhs.origin.y;
+    T right = origin.x + size.x < rhs.origin.x + rhs.size.x
+                  ? origin.x + size.x
+                  : rhs.origin.x + rhs.size.x;
+    T bottom = origin.y + size.y < rhs.origin.y + rhs.size.y
+                   ? origin.y + size.y
+                   : rhs.origin.y + rhs.size.y;
+    return Rectangle({left, top}, {right - left, bottom - top});
+  }
+
+  /**
+   * @brief 同时包含两个矩形的最小矩形，空矩形不参与计算
+   */
+  [[nodiscard]] constexpr Rectangle united(const Rectangle& rhs) const {
+    if (empty()) {
+      return rhs;
+    }
+    if (rhs.empty()) {
+      return *this;
+    }
+    T left = origin.x < rhs.origin.x ? origin.x : rhs.origin.x;
+    T top = origin.y < rhs.origin.y ? origin.y : rhs.origin.y;
+    T right = origin.x + size.x > rhs.origin.x + rhs.size.x
+                  ? origin.x + size.x
+                  : rhs.origin.x + rhs.size.x;
+    T bottom = origin.y + size.y > rhs.origin.y + rhs.size.y
+                   ? origin.y + size.y
+                   : rhs.origin.y + rhs.size.y;
+    return Rectangle({left, top}, {right - left, bottom - top});
+  }
 };
 
 }  // namespace SSDUI::Geometry
\ No newline at end of file
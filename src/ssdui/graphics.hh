@@ -0,0 +1,17 @@
+#pragma once
+
+#include "ssdui/graphics/bitmap.hh"
+#include "ssdui/graphics/bitmap_cache.hh"
+#include "ssdui/graphics/byte_source.hh"
+#include "ssdui/graphics/display_list.hh"
+#include "ssdui/graphics/dither.hh"
+#include "ssdui/graphics/ellipse.hh"
+#include "ssdui/graphics/flash_font.hh"
+#include "ssdui/graphics/font.hh"
+#include "ssdui/graphics/font_compiler.hh"
+#include "ssdui/graphics/packbits.hh"
+#include "ssdui/graphics/pattern.hh"
+#include "ssdui/graphics/polygon.hh"
+#include "ssdui/graphics/surface.hh"
+#include "ssdui/graphics/transpose.hh"
+#include "ssdui/graphics/utf8.hh"
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SSDUI::Graphics {
+
+/**
+ * @brief 位图与目标合成的方式
+ */
+enum class RasterOp : std::uint8_t {
+  /**
+   * @brief 点亮位图中为 1 的像素
+   */
+  Or,
+  /**
+   * @brief 用位图覆盖目标，包括位图中为 0 的像素
+   */
+  Set,
+  /**
+   * @brief 熄灭位图中为 1 的像素
+   */
+  AndNot,
+  /**
+   * @brief 翻转位图中为 1 的像素
+   */
+  Xor,
+};
+
+/**
+ * @brief 只读的页格式位图，布局与 Surface 相同
+ *        第 page 页第 x 列位于 data[x + page * width]
+ */
+struct Bitmap {
+  const std::uint8_t* data{nullptr};
+  std::int32_t width{0};
+  std::int32_t pages{0};
+
+  [[nodiscard]] constexpr std::int32_t height() const { return pages * 8; }
+
+  [[nodiscard]] constexpr std::size_t size() const {
+    return static_cast<std::size_t>(width * pages);
+  }
+
+  [[nodiscard]] constexpr bool empty() const {
+    return data == nullptr || width <= 0 || pages <= 0;
+  }
+
+  [[nodiscard]] constexpr std::uint8_t at(std::int32_t x,
+                                          std::int32_t page) const {
+    return data[x + page * width];
+  }
+};
+
+/**
+ * @brief PackBits 压缩的页格式位图（packbits.hh）
+ *        解压后与 Bitmap 布局相同，按页优先、逐页逐列排列，
+ *        整页空白或横向平坦的区域压缩效果最好
+ */
+struct PackedBitmap {
+  const std::uint8_t* data{nullptr};
+
+  /**
+   * @brief 压缩数据的字节数
+   */
+  std::uint32_t size{0};
+  std::int32_t width{0};
+  std::int32_t pages{0};
+
+  [[nodiscard]] constexpr std::int32_t height() const { return pages * 8; }
+
+  [[nodiscard]] constexpr bool empty() const {
+    return data == nullptr || size == 0 || width <= 0 || pages <= 0;
+  }
+};
+
+/**
+ * @brief 以增量保存的页格式动画
+ *
+ *  数据由 frames + 1 条记录组成，多字节数值为小端序：
+ *    记录 0 为第 0 帧相对于全黑画面的增量，
+ *    记录 i 为第 i 帧相对于第 i - 1 帧的增量，
+ *    最后一条记录从最后一帧回到第 0 帧，用于循环播放。
+ *  每条记录以 uint16 的段数开头，每段为 uint16 字节偏移（页格式，
+ *  第 page 页第 x 列为 x + page * width）、uint8 长度与新的字节值。
+ */
+struct DeltaAnimation {
+  const std::uint8_t* data{nullptr};
+  std::uint32_t size{0};
+  std::int32_t width{0};
+  std::int32_t pages{0};
+  std::uint16_t frames{0};
+
+  [[nodiscard]] constexpr std::int32_t height() const { return pages * 8; }
+
+  [[nodiscard]] constexpr bool empty() const {
+    return data == nullptr || frames == 0 || width <= 0 || pages <= 0;
+  }
+};
+
+}  // namespace SSDUI::Graphics
@@ -0,0 +1,249 @@
+#pragma once
+
+/**
+ *  位图缓存
+ *
+ *  在一块固定大小的内存（arena）中为离屏位图分配空间，按最近最少使用淘汰。
+ *  位图以调用者提供的 key（通常是组件的地址）标识，尺寸变化时重新分配。
+ *  空闲空间足够但不连续时整理 arena，把位图依次前移。
+ *
+ *  arena 在 configure 时一次性分配，运行期间不再分配内存。
+ *  只应在渲染线程访问。
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#ifndef SSDUI_BITMAP_CACHE_SIZE
+/**
+ * @brief 默认的位图缓存大小（字节），为 0 时不缓存
+ */
+#define SSDUI_BITMAP_CACHE_SIZE 0
+#endif
+
+namespace SSDUI::Graphics {
+
+class BitmapCache {
+ public:
+  static constexpr std::size_t MAX_ENTRIES = 16;
+
+  /**
+   * @brief 缓存中的一张位图，指针在下一次 acquire 之前有效
+   */
+  struct Slot {
+    std::uint8_t* data;
+    std::int32_t width;
+    std::int32_t pages;
+
+    /**
+     * @brief 内容是否已经渲染，新分配的位图为 false 且已清零
+     */
+    bool valid;
+  };
+
+  struct Stats {
+    std::uint32_t hits{0};
+    std::uint32_t misses{0};
+    std::uint32_t evictions{0};
+
+    /**
+     * @brief 位图大于整个 arena 而无法缓存的次数
+     */
+    std::uint32_t failures{0};
+  };
+
+ private:
+  struct Entry {
+    const void* key;
+    std::size_t offset;
+    std::size_t size;
+    std::uint32_t used;
+    Slot slot;
+  };
+
+  std::vector<std::uint8_t> arena_;
+
+  /**
+   * @brief 按 offset 升序排列
+   */
+  std::array<Entry, MAX_ENTRIES> entries_{};
+  std::size_t count_{0};
+  std::uint32_t clock_{0};
+  Stats stats_{};
+
+  Entry* _find(const void* key) {
+    for (std::size_t i = 0; i < count_; i++) {
+      if (entries_[i].key == key) {
+        return &entries_[i];
+      }
+    }
+    return nullptr;
+  }
+
+  void _remove(std::size_t index) {
+    std::move(entries_.begin() + static_cast<std::ptrdiff_t>(index) + 1,
+              entries_.begin() + static_cast<std::ptrdiff_t>(count_),
+              entries_.begin() + static_cast<std::ptrdiff_t>(index));
+    --count_;
+  }
+
+  void _evict_lru() {
+    std::size_t lru = 0;
+    for (std::size_t i = 1; i < count_; i++) {
+      // 以差值比较，计数回绕后仍然正确
+      if (clock_ - entries_[i].used > clock_ - entries_[lru].used) {
+        lru = i;
+      }
+    }
+    _remove(lru);
+    ++stats_.evictions;
+  }
+
+  /**
+   * @brief 找到能容纳 size 字节的空隙，返回插入位置，没有时返回 count_ + 1
+   */
+  [[nodiscard]] std::size_t _find_gap(std::size_t size,
+                                      std::size_t& offset) const {
+    std::size_t end = 0;
+    for (std::size_t i = 0; i < count_; i++) {
+      if (entries_[i].offset - end >= size) {
+        offset = end;
+        return i;
+      }
+      end = entries_[i].offset + entries_[i].size;
+    }
+    if (arena_.size() - end >= size) {
+      offset = end;
+      return count_;
+    }
+    return count_ + 1;
+  }
+
+  void _compact() {
+    std::size_t cursor = 0;
+    for (std::size_t i = 0; i < count_; i++) {
+      auto& entry = entries_[i];
+      if (entry.offset != cursor) {
+        std::memmove(arena_.data() + cursor, arena_.data() + entry.offset,
+                     entry.size);
+        entry.offset = cursor;
+        entry.slot.data = arena_.data() + cursor;
+      }
+      cursor += entry.size;
+    }
+  }
+
+ public:
+  explicit BitmapCache(std::size_t budget = SSDUI_BITMAP_CACHE_SIZE)
+      : arena_(budget) {}
+
+  BitmapCache(const BitmapCache&) = delete;
+  BitmapCache(BitmapCache&&) = delete;
+  BitmapCache& operator=(const BitmapCache&) = delete;
+  BitmapCache& operator=(BitmapCache&&) = delete;
+
+  /**
+   * @brief 重新设置缓存大小，清空所有位图
+   *
+   * @param budget 字节数，为 0 时不缓存
+   */
+  void configure(std::size_t budget) {
+    arena_.assign(budget, 0);
+    arena_.shrink_to_fit();
+    count_ = 0;
+  }
+
+  /**
+   * @brief 获取 key 对应的位图，不存在或尺寸不同时重新分配，必要时淘汰其他位图
+   *
+   * @return Slot* 无法分配时返回 nullptr
+   */
+  Slot* acquire(const void* key, std::int32_t width, std::int32_t pages) {
+    ++clock_;
+    auto size = static_cast<std::size_t>(width * pages);
+
+    if (auto* entry = _find(key); entry != nullptr) {
+      if (entry->slot.width == width && entry->slot.pages == pages) {
+        entry->used = clock_;
+        ++stats_.hits;
+        return &entry->slot;
+      }
+      _remove(static_cast<std::size_t>(entry - entries_.data()));
+    }
+
+    ++stats_.misses;
+    if (size == 0 || size > arena_.size()) {
+      ++stats_.failures;
+      return nullptr;
+    }
+
+    if (count_ == MAX_ENTRIES) {
+      _evict_lru();
+    }
+
+    std::size_t offset = 0;
+    auto index = _find_gap(size, offset);
+    while (index > count_) {
+      std::size_t free = arena_.size();
+      for (std::size_t i = 0; i < count_; i++) {
+        free -= entries_[i].size;
+      }
+      if (free >= size) {
+        _compact();
+      } else {
+        _evict_lru();
+      }
+      index = _find_gap(size, offset);
+    }
+
+    std::move_backward(
+        entries_.begin() + static_cast<std::ptrdiff_t>(index),
+        entries_.begin() + static_cast<std::ptrdiff_t>(count_),
+        entries_.begin() + static_cast<std::ptrdiff_t>(count_) + 1);
+    ++count_;
+
+    auto* data = arena_.data() + offset;
+    std::fill(data, data + size, std::uint8_t{0});
+    entries_[index] = Entry{
+        .key = key,
+        .offset = offset,
+        .size = size,
+        .used = clock_,
+        .slot = Slot{data, width, pages, false},
+    };
+    return &entries_[index].slot;
+  }
+
+  /**
+   * @brief 移除 key 对应的位图
+   */
+  void evict(const void* key) {
+    if (auto* entry = _find(key); entry != nullptr) {
+      _remove(static_cast<std::size_t>(entry - entries_.data()));
+    }
+  }
+
+  void clear() { count_ = 0; }
+
+  [[nodiscard]] std::size_t budget() const { return arena_.size(); }
+
+  [[nodiscard]] std::size_t used() const {
+    std::size_t used = 0;
+    for (std::size_t i = 0; i < count_; i++) {
+      used += entries_[i].size;
+    }
+    return used;
+  }
+
+  [[nodiscard]] std::size_t size() const { return count_; }
+
+  [[nodiscard]] const Stats& stats() const { return stats_; }
+
+  void reset_stats() { stats_ = {}; }
+};
+
+}  // namespace SSDUI::Graphics
@@ -0,0 +1,129 @@
+#pragma once
+
+/**
+ *  只读字节源
+ *
+ *  大型资源（例如 CJK 字库）无法放入 RAM，只能按需从存储中读取。
+ *  字节源只需要支持按偏移读取，具体可以是：
+ *  - MemorySource：映射到地址空间的 flash（ESP32 的 rodata）或普通数组；
+ *  - MappedFile：主机上以 mmap 映射的文件，用于模拟与调试。
+ *  需要经由驱动读取的外部 flash 可以按相同的接口自行实现。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+#include "ssdui/common/concepts.hh"
+#include "ssdui/common/span.hh"
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SSDUI_HAS_MMAP 1
+#endif
+
+namespace SSDUI::Graphics {
+
+template <typename So>
+concept IsByteSource = requires(const So source, std::size_t offset,
+                                std::span<std::uint8_t> out) {
+  { source.size() } -> std::same_as<std::size_t>;
+
+  /**
+   * @brief 从 offset 开始读取 out.size() 个字节，返回实际读取的字节数
+   */
+  { source.read(offset, out) } -> std::same_as<std::size_t>;
+};
+
+class MemorySource {
+ private:
+  const std::uint8_t* data_{nullptr};
+  std::size_t size_{0};
+
+ public:
+  constexpr MemorySource() = default;
+  constexpr MemorySource(const std::uint8_t* data, std::size_t size)
+      : data_(data), size_(size) {}
+
+  [[nodiscard]] std::size_t size() const { return size_; }
+
+  std::size_t read(std::size_t offset, std::span<std::uint8_t> out) const {
+    if (offset >= size_) {
+      return 0;
+    }
+    auto count = out.size() < size_ - offset ? out.size() : size_ - offset;
+    std::memcpy(out.data(), data_ + offset, count);
+    return count;
+  }
+};
+
+#ifdef SSDUI_HAS_MMAP
+
+class MappedFile {
+ private:
+  const std::uint8_t* data_{nullptr};
+  std::size_t size_{0};
+
+  MappedFile(const std::uint8_t* data, std::size_t size)
+      : data_(data), size_(size) {}
+
+ public:
+  MappedFile() = default;
+  ~MappedFile() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<std::uint8_t*>(data_), size_);
+    }
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept
+      : data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)) {}
+  MappedFile& operator=(MappedFile&& other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+
+  /**
+   * @brief 以只读方式映射文件
+   *
+   * @return std::optional<MappedFile> 文件不存在或为空时返回 std::nullopt
+   */
+  static std::optional<MappedFile> open(const char* path) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+      return std::nullopt;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+      ::close(fd);
+      return std::nullopt;
+    }
+    auto size = static_cast<std::size_t>(info.st_size);
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // 映射建立后即可关闭文件
+    ::close(fd);
+    if (data == MAP_FAILED) {
+      return std::nullopt;
+    }
+    return MappedFile(static_cast<const std::uint8_t*>(data), size);
+  }
+
+  [[nodiscard]] std::size_t size() const { return size_; }
+
+  std::size_t read(std::size_t offset, std::span<std::uint8_t> out) const {
+    return MemorySource(data_, size_).read(offset, out);
+  }
+};
+
+#endif
+
+}  // namespace SSDUI::Graphics
@@ -0,0 +1,492 @@
+#pragma once
+
+/**
+ *  显示列表
+ *
+ *  记录绘制调用而不是立即光栅化。每条指令为一个操作码加若干 int16 参数，
+ *  全部以 int16 连续存放。同样的绘制调用序列得到同样的列表与哈希，
+ *  因此可以通过比较哈希判断一个组件的画面是否真的发生了变化。
+ *
+ *  录制通过 Graphics::Surface 完成：带有显示列表的表面把图元追加到列表中，
+ *  直接访问字节（Surface::at）的绘制无法被录制。
+ *  位图记录数据的地址和内容的摘要：重放时按地址读取，
+ *  地址不变、内容被改写的位图（例如组件自己持有的画面缓冲）会得到不同的哈希，
+ *  重新录制时能发现画面变化。数据需要在列表的生命周期内保持有效。
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include "ssdui/geometry/line.hh"
+#include "ssdui/graphics/bitmap.hh"
+#include "ssdui/graphics/pattern.hh"
+#include "ssdui/graphics/polygon.hh"
+#include "ssdui/geometry/rectangle.hh"
+
+namespace SSDUI::Graphics {
+
+enum class Op : std::int16_t {
+  Pixel,  // x, y
+  HSpan,  // x0, x1, y
+  VSpan,  // x, y0, y1
+  Fill,   // x, y, w, h
+  Frame,  // x, y, w, h
+  Line,   // x0, y0, x1, y1
+
+  Ellipse,       // x, y, w, h
+  FillEllipse,   // x, y, w, h
+  Arc,           // x, y, w, h, start, sweep, thickness
+  RoundedFrame,  // x, y, w, h, radius
+  RoundedFill,   // x, y, w, h, radius
+  Polygon,       // rule, count, x0, y0, x1, y1, ...
+  Stroke,        // x0, y0, x1, y1, width
+
+  PatternFill,         // x, y, w, h, pattern (4 words)
+  PatternFillEllipse,  // x, y, w, h, pattern (4 words)
+  PatternRoundedFill,  // x, y, w, h, radius, pattern (4 words)
+  PatternPolygon,      // rule, count, pattern (4 words), x0, y0, ...
+
+  PushClip,  // x, y, w, h
+  PopClip,   //
+
+  Blit,        // data (4 words), width, pages, x, y, op, digest (2 words)
+  MaskedBlit,  // data (4 words), mask (4 words), width, pages, x, y,
+               // digest (2 words)
+  PackedBlit,  // data (4 words), size (2 words), width, pages, x, y, op,
+               // digest (2 words)
+};
+
+class DisplayList {
+ public:
+  static constexpr std::size_t MAX_CLIP_DEPTH = 8;
+
+ private:
+  std::vector<std::int16_t> words_{};
+
+  static std::int16_t _pack(std::int32_t value) {
+    constexpr std::int32_t MIN = -32768;
+    constexpr std::int32_t MAX = 32767;
+    return static_cast<std::int16_t>(value < MIN   ? MIN
+                                     : value > MAX ? MAX
+                                                   : value);
+  }
+
+  void _emit_args(std::initializer_list<std::int32_t> args) {
+    for (auto arg : args) {
+      words_.push_back(_pack(arg));
+    }
+  }
+
+  void _emit(Op op, std::initializer_list<std::int32_t> args) {
+    words_.push_back(static_cast<std::int16_t>(op));
+    _emit_args(args);
+  }
+
+  /**
+   * @brief 地址统一按 64 位拆分为 4 个字，32 位平台的高位为 0
+   */
+  void _address(const std::uint8_t* data) {
+    auto address =
+        static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(data));
+    for (int i = 0; i < 4; i++) {
+      words_.push_back(static_cast<std::int16_t>(address >> (i * 16)));
+    }
+  }
+
+  /**
+   * @brief 位图内容的 FNV-1a 摘要，可以接着上一段数据继续计算
+   */
+  static std::uint32_t _digest(const std::uint8_t* data, std::size_t size,
+                               std::uint32_t hash = 2166136261U) {
+    if (data == nullptr) {
+      return hash;
+    }
+    for (std::size_t i = 0; i < size; i++) {
+      hash = (hash ^ data[i]) * 16777619U;
+    }
+    return hash;
+  }
+
+  void _u32(std::uint32_t value) {
+    words_.push_back(static_cast<std::int16_t>(value));
+    words_.push_back(static_cast<std::int16_t>(value >> 16));
+  }
+
+  void _pattern(const Pattern& pattern) {
+    for (std::size_t i = 0; i < 8; i += 2) {
+      words_.push_back(static_cast<std::int16_t>(
+          pattern.columns[i] | pattern.columns[i + 1] << 8));
+    }
+  }
+
+  static Pattern _unpack_pattern(const std::int16_t* words) {
+    Pattern pattern;
+    for (std::size_t i = 0; i < 8; i += 2) {
+      auto word = static_cast<std::uint16_t>(words[i / 2]);
+      pattern.columns[i] = static_cast<std::uint8_t>(word);
+      pattern.columns[i + 1] = static_cast<std::uint8_t>(word >> 8);
+    }
+    return pattern;
+  }
+
+  static const std::uint8_t* _pointer(const std::int16_t* words) {
+    std::uint64_t address = 0;
+    for (int i = 0; i < 4; i++) {
+      auto word = static_cast<std::uint16_t>(words[i]);
+      address |= static_cast<std::uint64_t>(word) << (i * 16);
+    }
+    return reinterpret_cast<const std::uint8_t*>(
+        static_cast<std::uintptr_t>(address));
+  }
+
+  /**
+   * @brief 指令的参数个数，变长的指令由前几个参数决定
+   */
+  static constexpr std::size_t _arity(Op op, const std::int16_t* arg) {
+    switch (op) {
+      case Op::Pixel:
+        return 2;
+      case Op::HSpan:
+      case Op::VSpan:
+        return 3;
+      case Op::Fill:
+      case Op::Frame:
+      case Op::Line:
+      case Op::Ellipse:
+      case Op::FillEllipse:
+      case Op::PushClip:
+        return 4;
+      case Op::RoundedFrame:
+      case Op::RoundedFill:
+      case Op::Stroke:
+        return 5;
+      case Op::Polygon:
+        return 2 + 2 * static_cast<std::size_t>(arg[1]);
+      case Op::PatternFill:
+      case Op::PatternFillEllipse:
+        return 8;
+      case Op::PatternRoundedFill:
+        return 9;
+      case Op::PatternPolygon:
+        return 6 + 2 * static_cast<std::size_t>(arg[1]);
+      case Op::Arc:
+        return 7;
+      case Op::PopClip:
+        return 0;
+      case Op::Blit:
+        return 11;
+      case Op::MaskedBlit:
+        return 14;
+      case Op::PackedBlit:
+        return 13;
+    }
+    return 0;
+  }
+
+ public:
+  void pixel(std::int32_t x, std::int32_t y) { _emit(Op::Pixel, {x, y}); }
+
+  void hspan(std::int32_t x0, std::int32_t x1, std::int32_t y) {
+    _emit(Op::HSpan, {x0, x1, y});
+  }
+
+  void vspan(std::int32_t x, std::int32_t y0, std::int32_t y1) {
+    _emit(Op::VSpan, {x, y0, y1});
+  }
+
+  void fill(const Geometry::Rectangle<std::int32_t>& rect) {
+    _emit(Op::Fill, {rect.origin.x, rect.origin.y, rect.size.x, rect.size.y});
+  }
+
+  void frame(const Geometry::Rectangle<std::int32_t>& rect) {
+    _emit(Op::Frame,
+          {rect.origin.x, rect.origin.y, rect.size.x, rect.size.y});
+  }
+
+  void line(const Geometry::Line<std::int32_t>& line) {
+    _emit(Op::Line, {line.start.x, line.start.y, line.end.x, line.end.y});
+  }
+
+  void ellipse(const Geometry::Rectangle<std::int32_t>& box) {
+    _emit(Op::Ellipse, {box.origin.x, box.origin.y, box.size.x, box.size.y});
+  }
+
+  void fill_ellipse(const Geometry::Rectangle<std::int32_t>& box) {
+    _emit(Op::FillEllipse,
+          {box.origin.x, box.origin.y, box.size.x, box.size.y});
+  }
+
+  void arc(const Geometry::Rectangle<std::int32_t>& box, std::int32_t start,
+           std::int32_t sweep, std::int32_t thickness) {
+    _emit(Op::Arc, {box.origin.x, box.origin.y, box.size.x, box.size.y, start,
+                    sweep, thickness});
+  }
+
+  void rounded_frame(const Geometry::Rectangle<std::int32_t>& rect,
+                     std::int32_t radius) {
+    _emit(Op::RoundedFrame,
+          {rect.origin.x, rect.origin.y, rect.size.x, rect.size.y, radius});
+  }
+
+  void rounded_fill(const Geometry::Rectangle<std::int32_t>& rect,
+                    std::int32_t radius) {
+    _emit(Op::RoundedFill,
+          {rect.origin.x, rect.origin.y, rect.size.x, rect.size.y, radius});
+  }
+
+  /**
+   * @brief 顶点数超过 MAX_POLYGON_VERTICES 时不记录
+   */
+  void polygon(std::span<const Geometry::Point<std::int32_t>> points,
+               FillRule rule) {
+    if (points.size() > MAX_POLYGON_VERTICES) {
+      return;
+    }
+    _emit(Op::Polygon, {static_cast<std::int32_t>(rule),
+                        static_cast<std::int32_t>(points.size())});
+    for (const auto& point : points) {
+      _emit_args({point.x, point.y});
+    }
+  }
+
+  void fill(const Geometry::Rectangle<std::int32_t>& rect,
+            const Pattern& pattern) {
+    _emit(Op::PatternFill,
+          {rect.origin.x, rect.origin.y, rect.size.x, rect.size.y});
+    _pattern(pattern);
+  }
+
+  void fill_ellipse(const Geometry::Rectangle<std::int32_t>& box,
+                    const Pattern& pattern) {
+    _emit(Op::PatternFillEllipse,
+          {box.origin.x, box.origin.y, box.size.x, box.size.y});
+    _pattern(pattern);
+  }
+
+  void rounded_fill(const Geometry::Rectangle<std::int32_t>& rect,
+                    std::int32_t radius, const Pattern& pattern) {
+    _emit(Op::PatternRoundedFill,
+          {rect.origin.x, rect.origin.y, rect.size.x, rect.size.y, radius});
+    _pattern(pattern);
+  }
+
+  void polygon(std::span<const Geometry::Point<std::int32_t>> points,
+               FillRule rule, const Pattern& pattern) {
+    if (points.size() > MAX_POLYGON_VERTICES) {
+      return;
+    }
+    _emit(Op::PatternPolygon, {static_cast<std::int32_t>(rule),
+                               static_cast<std::int32_t>(points.size())});
+    _pattern(pattern);
+    for (const auto& point : points) {
+      _emit_args({point.x, point.y});
+    }
+  }
+
+  void stroke(const Geometry::Line<std::int32_t>& segment,
+              std::int32_t width) {
+    _emit(Op::Stroke,
+          {segment.start.x, segment.start.y, segment.end.x, segment.end.y,
+           width});
+  }
+
+  /**
+   * @brief 重放时裁剪区域与外层求交，嵌套深度不超过 MAX_CLIP_DEPTH
+   */
+  void push_clip(const Geometry::Rectangle<std::int32_t>& rect) {
+    _emit(Op::PushClip,
+          {rect.origin.x, rect.origin.y, rect.size.x, rect.size.y});
+  }
+
+  void pop_clip() { _emit(Op::PopClip, {}); }
+
+  void blit(const Bitmap& bitmap, const Geometry::Point<std::int32_t>& at,
+            RasterOp op = RasterOp::Or) {
+    words_.push_back(static_cast<std::int16_t>(Op::Blit));
+    _address(bitmap.data);
+    _emit_args({bitmap.width, bitmap.pages, at.x, at.y,
+                static_cast<std::int32_t>(op)});
+    _u32(_digest(bitmap.data, bitmap.size()));
+  }
+
+  void blit(const Bitmap& bitmap, const Bitmap& mask,
+            const Geometry::Point<std::int32_t>& at) {
+    words_.push_back(static_cast<std::int16_t>(Op::MaskedBlit));
+    _address(bitmap.data);
+    _address(mask.data);
+    _emit_args({bitmap.width, bitmap.pages, at.x, at.y});
+    _u32(_digest(mask.data, bitmap.size(),
+                 _digest(bitmap.data, bitmap.size())));
+  }
+
+  void blit(const PackedBitmap& bitmap,
+            const Geometry::Point<std::int32_t>& at,
+            RasterOp op = RasterOp::Or) {
+    words_.push_back(static_cast<std::int16_t>(Op::PackedBlit));
+    _address(bitmap.data);
+    _u32(bitmap.size);
+    _emit_args({bitmap.width, bitmap.pages, at.x, at.y,
+                static_cast<std::int32_t>(op)});
+    _u32(_digest(bitmap.data, bitmap.size));
+  }
+
+  void clear() { words_.clear(); }
+
+  [[nodiscard]] bool empty() const { return words_.empty(); }
+
+  /**
+   * @brief 列表占用的 int16 个数
+   */
+  [[nodiscard]] std::size_t size() const { return words_.size(); }
+
+  void swap(DisplayList& other) noexcept { words_.swap(other.words_); }
+
+  bool operator==(const DisplayList& rhs) const {
+    return words_ == rhs.words_;
+  }
+
+  /**
+   * @brief 列表内容的 FNV-1a 哈希
+   */
+  [[nodiscard]] std::uint32_t hash() const {
+    std::uint32_t hash = 2166136261U;
+    for (auto word : words_) {
+      auto bits = static_cast<std::uint16_t>(word);
+      hash = (hash ^ (bits & 0xFFU)) * 16777619U;
+      hash = (hash ^ (bits >> 8U)) * 16777619U;
+    }
+    return hash;
+  }
+
+  /**
+   * @brief 在表面上重放，按表面的裁剪区域裁剪
+   *
+   * @param surface 目标表面，不应再带有显示列表
+   */
+  template <typename Su>
+  void replay(const Su& surface) const {
+    std::array<Geometry::Rectangle<std::int32_t>, MAX_CLIP_DEPTH> saved{};
+    std::size_t depth = 0;
+    // 超出深度的裁剪不生效，但仍需配对
+    std::size_t overflow = 0;
+    Su current = surface;
+
+    for (std::size_t i = 0; i < words_.size();) {
+      auto op = static_cast<Op>(words_[i]);
+      const auto* arg = words_.data() + i + 1;
+      switch (op) {
+        case Op::PushClip:
+          if (depth == MAX_CLIP_DEPTH) {
+            ++overflow;
+            break;
+          }
+          saved[depth++] = current.clip();
+          current = current.clipped({{arg[0], arg[1]}, {arg[2], arg[3]}});
+          break;
+        case Op::PopClip:
+          if (overflow > 0) {
+            --overflow;
+          } else if (depth > 0) {
+            current = surface.clipped(saved[--depth]);
+          }
+          break;
+        case Op::Pixel:
+          current.pixel(arg[0], arg[1]);
+          break;
+        case Op::HSpan:
+          current.hspan(arg[0], arg[1], arg[2]);
+          break;
+        case Op::VSpan:
+          current.vspan(arg[0], arg[1], arg[2]);
+          break;
+        case Op::Fill:
+          current.fill({{arg[0], arg[1]}, {arg[2], arg[3]}});
+          break;
+        case Op::Frame:
+          current.frame({{arg[0], arg[1]}, {arg[2], arg[3]}});
+          break;
+        case Op::Line:
+          current.line({{arg[0], arg[1]}, {arg[2], arg[3]}});
+          break;
+        case Op::Ellipse:
+          current.ellipse({{arg[0], arg[1]}, {arg[2], arg[3]}});
+          break;
+        case Op::FillEllipse:
+          current.fill_ellipse({{arg[0], arg[1]}, {arg[2], arg[3]}});
+          break;
+        case Op::Arc:
+          current.arc({{arg[0], arg[1]}, {arg[2], arg[3]}}, arg[4], arg[5],
+                      arg[6]);
+          break;
+        case Op::RoundedFrame:
+          current.rounded_frame({{arg[0], arg[1]}, {arg[2], arg[3]}}, arg[4]);
+          break;
+        case Op::RoundedFill:
+          current.rounded_fill({{arg[0], arg[1]}, {arg[2], arg[3]}}, arg[4]);
+          break;
+        case Op::Polygon: {
+          std::array<Geometry::Point<std::int32_t>, MAX_POLYGON_VERTICES>
+              points{};
+          auto count = static_cast<std::size_t>(arg[1]);
+          for (std::size_t k = 0; k < count; k++) {
+            points[k] = {arg[2 + 2 * k], arg[3 + 2 * k]};
+          }
+          current.polygon({points.data(), count},
+                          static_cast<FillRule>(arg[0]));
+          break;
+        }
+        case Op::PatternFill:
+          current.fill({{arg[0], arg[1]}, {arg[2], arg[3]}},
+                       _unpack_pattern(arg + 4));
+          break;
+        case Op::PatternFillEllipse:
+          current.fill_ellipse({{arg[0], arg[1]}, {arg[2], arg[3]}},
+                               _unpack_pattern(arg + 4));
+          break;
+        case Op::PatternRoundedFill:
+          current.rounded_fill({{arg[0], arg[1]}, {arg[2], arg[3]}}, arg[4],
+                               _unpack_pattern(arg + 5));
+          break;
+        case Op::PatternPolygon: {
+          std::array<Geometry::Point<std::int32_t>, MAX_POLYGON_VERTICES>
+              points{};
+          auto count = static_cast<std::size_t>(arg[1]);
+          for (std::size_t k = 0; k < count; k++) {
+            points[k] = {arg[6 + 2 * k], arg[7 + 2 * k]};
+          }
+          current.polygon({points.data(), count},
+                          static_cast<FillRule>(arg[0]),
+                          _unpack_pattern(arg + 2));
+          break;
+        }
+        case Op::Stroke:
+          current.stroke({{arg[0], arg[1]}, {arg[2], arg[3]}}, arg[4]);
+          break;
+        case Op::Blit:
+          current.blit(Bitmap{_pointer(arg), arg[4], arg[5]}, {arg[6], arg[7]},
+                       static_cast<RasterOp>(arg[8]));
+          break;
+        case Op::MaskedBlit:
+          current.blit(Bitmap{_pointer(arg), arg[8], arg[9]},
+                       Bitmap{_pointer(arg + 4), arg[8], arg[9]},
+                       {arg[10], arg[11]});
+          break;
+        case Op::PackedBlit: {
+          auto size = static_cast<std::uint32_t>(
+              static_cast<std::uint16_t>(arg[4]) |
+              static_cast<std::uint32_t>(static_cast<std::uint16_t>(arg[5]))
+                  << 16);
+          current.blit(PackedBitmap{_pointer(arg), size, arg[6], arg[7]},
+                       {arg[8], arg[9]}, static_cast<RasterOp>(arg[10]));
+          break;
+        }
+      }
+      i += 1 + _arity(op, arg);
+    }
+  }
+};
+
+}  // namespace SSDUI::Graphics
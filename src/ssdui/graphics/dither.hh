@@ -0,0 +1,216 @@
+#pragma once
+
+/**
+ *  灰度图像的 1 位抖动
+ *
+ *  Ditherer 每次处理一行 8 位灰度（0 为暗、255 为亮），
+ *  直接把结果写入页格式缓冲中对应的位，不需要整幅灰度图的副本：
+ *  误差扩散只保留两到三行 int16 误差，数据可以来自相机逐行读出或文件逐行读取。
+ *
+ *  - Threshold：固定阈值，最快；
+ *  - Ordered：8x8 Bayer 有序抖动，与 Pattern::gray 的阈值相同，
+ *    像素之间互不依赖，每 8 列一组展开，主机上可以自动向量化；
+ *  - FloydSteinberg：误差按 7/16、3/16、5/16、1/16 扩散，层次最细；
+ *  - Atkinson：误差的 6/8 扩散到 6 个邻居，对比度更高，适合小屏幕。
+ *
+ *  误差扩散只用整数与移位：同一行向右的误差保存在寄存器中，
+ *  下一行的误差在首次写入时直接赋值，不需要每行清零。
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ssdui/graphics/pattern.hh"
+
+namespace SSDUI::Graphics {
+
+enum class Dither : std::uint8_t {
+  Threshold,
+  Ordered,
+  FloydSteinberg,
+  Atkinson,
+};
+
+namespace Detail {
+
+/**
+ * @brief 有序抖动的阈值，灰度大于阈值时点亮，
+ *        0 全暗、255 全亮，点亮的比例约为 gray / 256
+ */
+struct OrderedThresholds {
+  std::uint8_t rows[8][8]{};
+
+  constexpr OrderedThresholds() {
+    for (std::int32_t y = 0; y < 8; y++) {
+      for (std::int32_t x = 0; x < 8; x++) {
+        rows[y][x] = static_cast<std::uint8_t>(bayer(x, y) * 4 + 2);
+      }
+    }
+  }
+};
+
+inline constexpr OrderedThresholds ORDERED_THRESHOLDS{};
+
+}  // namespace Detail
+
+class Ditherer {
+ private:
+  std::int32_t width_;
+  Dither method_;
+  std::uint8_t threshold_;
+
+  /**
+   * @brief 下一行的行号
+   */
+  std::int32_t row_{0};
+
+  /**
+   * @brief 三行误差的环形缓冲，每行左右各留一个元素，避免边界判断
+   */
+  std::vector<std::int16_t> errors_;
+
+  [[nodiscard]] std::int16_t* _errors(std::int32_t row) {
+    auto stride = static_cast<std::size_t>(width_) + 2;
+    return errors_.data() + static_cast<std::size_t>(row % 3) * stride + 1;
+  }
+
+  static void _put(std::uint8_t* page, std::int32_t x, std::uint8_t bit,
+                   bool lit) {
+    page[x] = static_cast<std::uint8_t>((page[x] & ~bit) | (lit ? bit : 0U));
+  }
+
+  /**
+   * @brief 与每 8 列循环的阈值比较，灰度大于阈值时点亮
+   *
+   * 灰度与页可能重叠，编译器不敢直接向量化逐列的读改写；
+   * 每 8 列先把结果算到局部数组再写入，两段都是定长的直线代码，可以整组处理
+   */
+  static void _compare(const std::uint8_t* gray, std::uint8_t* page,
+                       std::uint8_t bit, const std::uint8_t* thresholds,
+                       std::int32_t width) {
+    auto keep = static_cast<std::uint8_t>(~bit);
+    std::int32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+      std::uint8_t lit[8];
+      for (std::int32_t i = 0; i < 8; i++) {
+        lit[i] = gray[x + i] > thresholds[i] ? bit : 0;
+      }
+      for (std::int32_t i = 0; i < 8; i++) {
+        page[x + i] = static_cast<std::uint8_t>((page[x + i] & keep) | lit[i]);
+      }
+    }
+    for (; x < width; x++) {
+      _put(page, x, bit, gray[x] > thresholds[x & 7]);
+    }
+  }
+
+  void _floyd_steinberg(const std::uint8_t* gray, std::uint8_t* page,
+                        std::uint8_t bit) {
+    const auto* current = _errors(row_);
+    auto* next = _errors(row_ + 1);
+    auto width = width_;
+    std::int32_t right = 0;
+    next[0] = 0;
+    for (std::int32_t x = 0; x < width; x++) {
+      auto value = gray[x] + current[x] + right;
+      auto lit = value >= 128;
+      auto error = value - (lit ? 255 : 0);
+      _put(page, x, bit, lit);
+
+      right = (error * 7) >> 4;
+      auto below_left = (error * 3) >> 4;
+      auto below = (error * 5) >> 4;
+      next[x - 1] = static_cast<std::int16_t>(next[x - 1] + below_left);
+      next[x] = static_cast<std::int16_t>(next[x] + below);
+      // 余下的部分给右下方，误差不因舍入丢失
+      next[x + 1] =
+          static_cast<std::int16_t>(error - right - below_left - below);
+    }
+  }
+
+  void _atkinson(const std::uint8_t* gray, std::uint8_t* page,
+                 std::uint8_t bit) {
+    const auto* current = _errors(row_);
+    auto* next = _errors(row_ + 1);
+    auto* after = _errors(row_ + 2);
+    std::int32_t right = 0;
+    auto width = width_;
+    std::int32_t right2 = 0;
+    for (std::int32_t x = 0; x < width; x++) {
+      auto value = gray[x] + current[x] + right;
+      auto lit = value >= 128;
+      auto share = (value - (lit ? 255 : 0)) >> 3;
+      _put(page, x, bit, lit);
+
+      right = right2 + share;
+      right2 = share;
+      next[x - 1] = static_cast<std::int16_t>(next[x - 1] + share);
+      next[x] = static_cast<std::int16_t>(next[x] + share);
+      next[x + 1] = static_cast<std::int16_t>(next[x + 1] + share);
+      // 隔一行的缓冲每列只在这里写入一次
+      after[x] = static_cast<std::int16_t>(share);
+    }
+  }
+
+ public:
+  /**
+   * @param width 每行的像素数
+   * @param method 抖动方式
+   * @param threshold Threshold 方式的阈值，灰度大于它时点亮
+   */
+  explicit Ditherer(std::int32_t width, Dither method = Dither::FloydSteinberg,
+                    std::uint8_t threshold = 127)
+      : width_(width > 0 ? width : 0),
+        method_(method),
+        threshold_(threshold),
+        errors_(3 * (static_cast<std::size_t>(width_) + 2), 0) {}
+
+  [[nodiscard]] std::int32_t width() const { return width_; }
+  [[nodiscard]] Dither method() const { return method_; }
+
+  void set_method(Dither method) {
+    method_ = method;
+    reset();
+  }
+
+  /**
+   * @brief 开始新的一帧，清除上一帧遗留的误差
+   */
+  void reset() {
+    row_ = 0;
+    std::fill(errors_.begin(), errors_.end(), 0);
+  }
+
+  /**
+   * @brief 处理下一行
+   *
+   * @param gray 本行的灰度，width 个字节
+   * @param page 本行所在页的第 0 列，页格式
+   * @param bit 本行在页中的位（1 << (y % 8)），只修改这一位
+   */
+  void row(const std::uint8_t* gray, std::uint8_t* page, std::uint8_t bit) {
+    switch (method_) {
+      case Dither::Threshold: {
+        std::uint8_t thresholds[8];
+        std::fill(thresholds, thresholds + 8, threshold_);
+        _compare(gray, page, bit, thresholds, width_);
+        break;
+      }
+      case Dither::Ordered:
+        _compare(gray, page, bit, Detail::ORDERED_THRESHOLDS.rows[row_ & 7],
+                 width_);
+        break;
+      case Dither::FloydSteinberg:
+        _floyd_steinberg(gray, page, bit);
+        break;
+      case Dither::Atkinson:
+        _atkinson(gray, page, bit);
+        break;
+    }
+    row_++;
+  }
+};
+
+}  // namespace SSDUI::Graphics
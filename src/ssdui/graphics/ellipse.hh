@@ -0,0 +1,178 @@
+#pragma once
+
+/**
+ *  椭圆的逐行扫描
+ *
+ *  椭圆内切于 width x height 的包围盒，像素中心落在椭圆内（含边界）即点亮。
+ *  坐标取两倍以避开偶数尺寸时半像素的中心，全部为整数运算。
+ *
+ *  EllipseRows 从中间的行开始向上下两侧逐行推进，
+ *  每行的半宽只会减小：沿用中点法的判别式逐步收缩，
+ *  整个椭圆只需 O(width + height) 次判定，不需要开方或浮点。
+ *  每行得到左右对称的一段，填充与边框都以水平区间输出。
+ *
+ *  AngleRange 判断一个方向是否在圆弧的角度范围内，只用叉积比较，
+ *  起止方向由查表得到的正弦值确定。
+ */
+
+#include <cstdint>
+
+namespace SSDUI::Graphics {
+
+class EllipseRows {
+ private:
+  std::int64_t width_sq_;
+  std::int64_t height_sq_;
+  std::int64_t limit_;
+  std::int32_t width_;
+  std::int32_t height_;
+
+  /**
+   * @brief 当前行到中心的距离与半宽，两倍坐标
+   *        半宽小于 0 表示此行及更外侧的行没有像素
+   */
+  std::int32_t y_;
+  std::int32_t x_;
+
+  void _settle() {
+    auto y_sq = static_cast<std::int64_t>(y_) * y_ * width_sq_;
+    while (x_ >= 0 &&
+           static_cast<std::int64_t>(x_) * x_ * height_sq_ + y_sq > limit_) {
+      x_ -= 2;
+    }
+  }
+
+ public:
+  EllipseRows(std::int32_t width, std::int32_t height)
+      : width_sq_(static_cast<std::int64_t>(width) * width),
+        height_sq_(static_cast<std::int64_t>(height) * height),
+        limit_(width_sq_ * height_sq_),
+        width_(width),
+        height_(height),
+        y_((height & 1) != 0 ? 0 : 1),
+        x_(width - 1) {
+    if (width <= 0 || height <= 0) {
+      x_ = -1;
+      return;
+    }
+    _settle();
+  }
+
+  [[nodiscard]] bool done() const { return x_ < 0 || y_ >= height_; }
+
+  /**
+   * @brief 当前的上下两行，相对包围盒顶部；高度为奇数时中间一行上下相同
+   */
+  [[nodiscard]] std::int32_t top() const { return (height_ - 1 - y_) / 2; }
+  [[nodiscard]] std::int32_t bottom() const { return (height_ - 1 + y_) / 2; }
+
+  /**
+   * @brief 当前行最左侧的像素相对包围盒左侧的列数，右侧对称
+   */
+  [[nodiscard]] std::int32_t inset() const { return (width_ - 1 - x_) / 2; }
+
+  /**
+   * @brief 向外推进一行
+   */
+  void next() {
+    y_ += 2;
+    _settle();
+  }
+};
+
+namespace Detail {
+
+/**
+ * @brief sin(0..90 度)，Q14 定点
+ */
+inline constexpr std::int16_t SINE_TABLE[91] = {
+    0,     286,   572,   857,   1143,  1428,  1713,  1997,  2280,  2563,
+    2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+    5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+    8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860,  10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384,
+};
+
+/**
+ * @brief 任意整数角度（度）的正弦，Q14 定点
+ */
+constexpr std::int32_t sine(std::int32_t degrees) {
+  degrees %= 360;
+  if (degrees < 0) {
+    degrees += 360;
+  }
+  if (degrees <= 90) {
+    return SINE_TABLE[degrees];
+  }
+  if (degrees <= 180) {
+    return SINE_TABLE[180 - degrees];
+  }
+  if (degrees <= 270) {
+    return -SINE_TABLE[degrees - 180];
+  }
+  return -SINE_TABLE[360 - degrees];
+}
+
+constexpr std::int32_t cosine(std::int32_t degrees) {
+  return sine(degrees + 90);
+}
+
+}  // namespace Detail
+
+/**
+ * @brief 圆弧的角度范围
+ *        0 度指向右侧，角度沿顺时针（屏幕坐标 y 向下）增加
+ */
+class AngleRange {
+ private:
+  std::int32_t start_x_{0};
+  std::int32_t start_y_{0};
+  std::int32_t end_x_{0};
+  std::int32_t end_y_{0};
+  std::int32_t sweep_{0};
+
+ public:
+  /**
+   * @param start 起始角度（度）
+   * @param sweep 扫过的角度，负数表示逆时针，360 及以上为整圆
+   */
+  constexpr AngleRange(std::int32_t start, std::int32_t sweep) {
+    if (sweep < 0) {
+      start += sweep;
+      sweep = -sweep;
+    }
+    sweep_ = sweep > 360 ? 360 : sweep;
+    start_x_ = Detail::cosine(start);
+    start_y_ = Detail::sine(start);
+    end_x_ = Detail::cosine(start + sweep_);
+    end_y_ = Detail::sine(start + sweep_);
+  }
+
+  [[nodiscard]] constexpr bool empty() const { return sweep_ == 0; }
+  [[nodiscard]] constexpr bool full() const { return sweep_ == 360; }
+
+  /**
+   * @brief 方向 (x, y) 是否在范围内（含两端）
+   */
+  [[nodiscard]] constexpr bool contains(std::int32_t x, std::int32_t y) const {
+    if (sweep_ == 360) {
+      return true;
+    }
+    auto after_start = static_cast<std::int64_t>(start_x_) * y -
+                       static_cast<std::int64_t>(start_y_) * x;
+    auto before_end = static_cast<std::int64_t>(end_y_) * x -
+                      static_cast<std::int64_t>(end_x_) * y;
+    if (sweep_ <= 180) {
+      return sweep_ != 0 && after_start >= 0 && before_end >= 0;
+    }
+    // 超过半圆时判断是否落在补集的内部
+    return after_start >= 0 || before_end >= 0;
+  }
+};
+
+}  // namespace SSDUI::Graphics
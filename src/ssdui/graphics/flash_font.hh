@@ -0,0 +1,334 @@
+#pragma once
+
+/**
+ *  存储在 flash 或文件中的大型字库
+ *
+ *  字库整体留在字节源中，只有最近使用的字形被解码到 RAM 中固定大小的缓存里，
+ *  缓存满时淘汰最近最少使用的字形。解码后的字形为页格式，可直接复制到表面上。
+ *
+ *  文件格式（小端序，可由 tools/ssdf.py 从 BDF 字体生成）：
+ *    文件头 16 字节：
+ *      "SSDF"、版本 u8、行高（页）u8、缺失字符宽度 u8、保留 u8、
+ *      字形数 u32、字距调整数 u32
+ *    字形索引，按码位升序，每项 16 字节：
+ *      码位 u32、数据偏移 u32、数据大小 u16、
+ *      列数 u8、页数 u8、顶部页 u8、左偏移 i8、前进宽度 u8、编码 u8
+ *    字距调整，按 (left, right) 升序，每项 12 字节：
+ *      left u32、right u32、调整 i8、保留 3 字节
+ *    字形数据，编码为 0 时原样存放，为 1 时为 PackBits 游程编码（packbits.hh）
+ *
+ *  查找字形为二分查找，O(log n) 次读取。字库中不存在的码位同样占用一个缓存槽，
+ *  反复绘制缺失的字符时不会每次都重新查找。只应在渲染线程访问。
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "ssdui/common/span.hh"
+#include "ssdui/context/clock.hh"
+#include "ssdui/graphics/bitmap.hh"
+#include "ssdui/graphics/byte_source.hh"
+#include "ssdui/graphics/font.hh"
+#include "ssdui/graphics/packbits.hh"
+
+namespace SSDUI::Graphics {
+
+/**
+ * @brief 字形缓存的统计信息，用于确定缓存的大小
+ */
+struct GlyphCacheStats {
+  std::uint32_t hits{0};
+  std::uint32_t misses{0};
+  std::uint32_t evictions{0};
+
+  /**
+   * @brief 字形大于缓存槽而无法缓存的次数
+   */
+  std::uint32_t failures{0};
+
+  /**
+   * @brief 未命中时加载字形（查找、读取并解压）的总耗时与最大耗时
+   */
+  Context::Clock::duration decode_time{};
+  Context::Clock::duration decode_max{};
+
+  [[nodiscard]] float hit_rate() const {
+    auto total = hits + misses;
+    return total == 0 ? 0.0F
+                      : static_cast<float>(hits) / static_cast<float>(total);
+  }
+};
+
+/**
+ * @tparam So 字节源
+ * @tparam Slots 缓存的字形数
+ * @tparam SlotBytes 每个字形的最大字节数（列数 * 页数）
+ */
+template <IsByteSource So, std::size_t Slots = 32, std::size_t SlotBytes = 64>
+class FlashFont {
+ public:
+  static constexpr std::size_t HEADER_SIZE = 16;
+  static constexpr std::size_t GLYPH_SIZE = 16;
+  static constexpr std::size_t KERNING_SIZE = 12;
+  static constexpr std::uint8_t VERSION = 1;
+
+  /**
+   * @brief 空缓存槽的键，不是合法的码位
+   */
+  static constexpr char32_t EMPTY = 0xFFFFFFFF;
+
+  enum class Encoding : std::uint8_t {
+    Raw = 0,
+    PackBits = 1,
+  };
+
+ private:
+  enum class Search : std::uint8_t {
+    Found,
+    Missing,
+    /**
+     * @brief 读取失败，结果未知，不缓存
+     */
+    Failed,
+  };
+
+  So source_;
+  std::uint32_t glyph_count_{0};
+  std::uint32_t kerning_count_{0};
+  std::int32_t pages_{0};
+  std::int32_t blank_{0};
+
+  /**
+   * @brief 缓存槽，keys_ 单独存放以便顺序比较
+   */
+  std::array<char32_t, Slots> keys_{};
+  std::array<Glyph, Slots> glyphs_{};
+
+  /**
+   * @brief 缓存槽记录的是字库中不存在的码位
+   */
+  std::array<bool, Slots> missing_{};
+  std::array<std::uint32_t, Slots> used_{};
+  std::array<std::uint8_t, Slots * SlotBytes> data_{};
+  std::size_t count_{0};
+  std::uint32_t clock_{0};
+  GlyphCacheStats stats_{};
+
+  FlashFont(So source, std::uint32_t glyph_count, std::uint32_t kerning_count,
+            std::int32_t pages, std::int32_t blank)
+      : source_(std::move(source)),
+        glyph_count_(glyph_count),
+        kerning_count_(kerning_count),
+        pages_(pages),
+        blank_(blank) {}
+
+  static std::uint32_t _u32(const std::uint8_t* bytes) {
+    return static_cast<std::uint32_t>(bytes[0]) |
+           static_cast<std::uint32_t>(bytes[1]) << 8U |
+           static_cast<std::uint32_t>(bytes[2]) << 16U |
+           static_cast<std::uint32_t>(bytes[3]) << 24U;
+  }
+
+  /**
+   * @brief 读取第 index 个字形索引
+   */
+  bool _entry(std::size_t index, std::array<std::uint8_t, GLYPH_SIZE>& out) {
+    return source_.read(HEADER_SIZE + index * GLYPH_SIZE, out) == GLYPH_SIZE;
+  }
+
+  /**
+   * @brief 二分查找码位，找到时 entry 为它的字形索引
+   */
+  Search _search(char32_t codepoint,
+                 std::array<std::uint8_t, GLYPH_SIZE>& entry) {
+    std::size_t lo = 0;
+    std::size_t hi = glyph_count_;
+    while (lo < hi) {
+      auto mid = lo + (hi - lo) / 2;
+      if (!_entry(mid, entry)) {
+        return Search::Failed;
+      }
+      auto key = _u32(entry.data());
+      if (key == codepoint) {
+        return Search::Found;
+      }
+      if (key < codepoint) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return Search::Missing;
+  }
+
+  std::size_t _slot() {
+    if (count_ < Slots) {
+      return count_++;
+    }
+    std::size_t lru = 0;
+    for (std::size_t i = 1; i < Slots; i++) {
+      if (clock_ - used_[i] > clock_ - used_[lru]) {
+        lru = i;
+      }
+    }
+    ++stats_.evictions;
+    return lru;
+  }
+
+  const Glyph* _load(char32_t codepoint) {
+    auto start = Context::Clock::now();
+    std::array<std::uint8_t, GLYPH_SIZE> entry{};
+    auto found = _search(codepoint, entry);
+    if (found == Search::Missing) {
+      auto slot = _slot();
+      keys_[slot] = codepoint;
+      missing_[slot] = true;
+      used_[slot] = clock_;
+      return nullptr;
+    }
+    if (found == Search::Failed) {
+      return nullptr;
+    }
+
+    Glyph glyph{
+        .codepoint = codepoint,
+        .offset = 0,
+        .width = entry[10],
+        .pages = entry[11],
+        .top = entry[12],
+        .left = static_cast<std::int8_t>(entry[13]),
+        .advance = entry[14],
+    };
+    auto offset = _u32(entry.data() + 4);
+    std::size_t stored = entry[8] | static_cast<std::size_t>(entry[9]) << 8U;
+    auto encoding = static_cast<Encoding>(entry[15]);
+    std::size_t size = static_cast<std::size_t>(glyph.width) * glyph.pages;
+    if (size > SlotBytes) {
+      ++stats_.failures;
+      return nullptr;
+    }
+
+    auto slot = _slot();
+    std::span<std::uint8_t> out{data_.data() + slot * SlotBytes, size};
+    bool ok = false;
+    if (encoding == Encoding::Raw) {
+      ok = stored == size && source_.read(offset, out) == size;
+    } else if (encoding == Encoding::PackBits) {
+      // PackBits 最坏情况下的膨胀不超过一倍
+      std::array<std::uint8_t, SlotBytes * 2> packed{};
+      ok = stored <= packed.size() &&
+           source_.read(offset, {packed.data(), stored}) == stored &&
+           PackBitsReader(packed.data(), stored).read(out);
+    }
+    if (!ok) {
+      // 数据损坏，槽位留空
+      keys_[slot] = EMPTY;
+      return nullptr;
+    }
+
+    glyph.offset = static_cast<std::uint32_t>(slot * SlotBytes);
+    keys_[slot] = codepoint;
+    missing_[slot] = false;
+    glyphs_[slot] = glyph;
+    used_[slot] = clock_;
+
+    auto elapsed = Context::Clock::now() - start;
+    stats_.decode_time += elapsed;
+    if (elapsed > stats_.decode_max) {
+      stats_.decode_max = elapsed;
+    }
+    return &glyphs_[slot];
+  }
+
+ public:
+  /**
+   * @brief 打开字库，检查文件头与索引的范围
+   *
+   * @return std::optional<FlashFont> 格式不正确时返回 std::nullopt
+   */
+  static std::optional<FlashFont> open(So source) {
+    std::array<std::uint8_t, HEADER_SIZE> header{};
+    if (source.read(0, header) != HEADER_SIZE || header[0] != 'S' ||
+        header[1] != 'S' || header[2] != 'D' || header[3] != 'F' ||
+        header[4] != VERSION) {
+      return std::nullopt;
+    }
+    auto glyph_count = _u32(header.data() + 8);
+    auto kerning_count = _u32(header.data() + 12);
+    auto tables = HEADER_SIZE + std::size_t{glyph_count} * GLYPH_SIZE +
+                  std::size_t{kerning_count} * KERNING_SIZE;
+    if (tables > source.size()) {
+      return std::nullopt;
+    }
+    return FlashFont(std::move(source), glyph_count, kerning_count,
+                     header[5], header[6]);
+  }
+
+  [[nodiscard]] std::int32_t pages() const { return pages_; }
+  [[nodiscard]] std::int32_t height() const { return pages_ * 8; }
+  [[nodiscard]] std::int32_t blank() const { return blank_; }
+  [[nodiscard]] std::size_t size() const { return glyph_count_; }
+
+  /**
+   * @brief 查找码位对应的字形，未缓存时从字节源中解码
+   *
+   * @return const Glyph* 不存在时返回 nullptr，指针在下一次 find 之前有效
+   */
+  const Glyph* find(char32_t codepoint) {
+    ++clock_;
+    for (std::size_t i = 0; i < count_; i++) {
+      if (keys_[i] == codepoint) {
+        used_[i] = clock_;
+        ++stats_.hits;
+        return missing_[i] ? nullptr : &glyphs_[i];
+      }
+    }
+    ++stats_.misses;
+    return _load(codepoint);
+  }
+
+  [[nodiscard]] Bitmap bitmap(const Glyph& glyph) const {
+    return {data_.data() + glyph.offset, glyph.width, glyph.pages};
+  }
+
+  std::int32_t kerning(char32_t left, char32_t right) {
+    if (kerning_count_ == 0) {
+      return 0;
+    }
+    auto base = HEADER_SIZE + std::size_t{glyph_count_} * GLYPH_SIZE;
+    std::array<std::uint8_t, KERNING_SIZE> pair{};
+    std::size_t lo = 0;
+    std::size_t hi = kerning_count_;
+    while (lo < hi) {
+      auto mid = lo + (hi - lo) / 2;
+      if (source_.read(base + mid * KERNING_SIZE, pair) != KERNING_SIZE) {
+        return 0;
+      }
+      auto l = _u32(pair.data());
+      auto r = _u32(pair.data() + 4);
+      if (l == left && r == right) {
+        return static_cast<std::int8_t>(pair[8]);
+      }
+      if (l < left || (l == left && r < right)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return 0;
+  }
+
+  [[nodiscard]] const GlyphCacheStats& stats() const { return stats_; }
+
+  void reset_stats() { stats_ = {}; }
+
+  /**
+   * @brief 清空缓存，不影响统计信息
+   */
+  void clear() { count_ = 0; }
+};
+
+}  // namespace SSDUI::Graphics
@@ -0,0 +1,191 @@
+#pragma once
+
+/**
+ *  点阵字体
+ *
+ *  字形按页格式存放，与 Surface 相同，可以直接作为 Bitmap 复制到表面上。
+ *  每个字形只保存有墨迹的列与页，并记录它相对于笔位置的偏移与前进宽度，
+ *  因此同一格式既可以表示等宽字体，也可以表示比例字体。
+ *
+ *  字形按码位升序排列：ASCII 通过 128 项的索引表 O(1) 查找，
+ *  其余码位二分查找。字距调整表按 (left, right) 升序排列。
+ *
+ *  Font 只是对这些表的视图，表通常由 compile_font 在编译期生成并放在 flash 中。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "ssdui/graphics/bitmap.hh"
+#include "ssdui/graphics/utf8.hh"
+
+namespace SSDUI::Graphics {
+
+struct Glyph {
+  char32_t codepoint;
+
+  /**
+   * @brief 位图在字库数据中的偏移
+   */
+  std::uint32_t offset;
+
+  /**
+   * @brief 位图的列数与页数，空白字形为 0
+   */
+  std::uint8_t width;
+  std::uint8_t pages;
+
+  /**
+   * @brief 位图第一页相对于行顶部的页数
+   */
+  std::uint8_t top;
+
+  /**
+   * @brief 位图第一列相对于笔位置的偏移
+   */
+  std::int8_t left;
+
+  /**
+   * @brief 绘制后笔位置前进的宽度
+   */
+  std::uint8_t advance;
+};
+
+struct Kerning {
+  char32_t left;
+  char32_t right;
+
+  /**
+   * @brief 两个字形之间额外的间距，通常为负数
+   */
+  std::int8_t adjust;
+};
+
+class Font {
+ public:
+  /**
+   * @brief ASCII 索引表中表示字形不存在的值
+   */
+  static constexpr std::uint16_t NONE = 0xFFFF;
+
+ private:
+  const Glyph* glyphs_{nullptr};
+  std::size_t glyph_count_{0};
+  const std::uint8_t* data_{nullptr};
+  const Kerning* kerning_{nullptr};
+  std::size_t kerning_count_{0};
+  const std::uint16_t* ascii_{nullptr};
+  std::int32_t pages_{0};
+  std::int32_t blank_{0};
+
+ public:
+  constexpr Font() = default;
+
+  /**
+   * @param glyphs 按码位升序排列的字形
+   * @param data 字形位图
+   * @param kerning 按 (left, right) 升序排列的字距调整，可以为空
+   * @param ascii 128 项的索引表，第 c 项为字符 c 在 glyphs 中的下标或 NONE
+   * @param pages 行高（页）
+   * @param blank 字库中不存在的字符占用的宽度
+   */
+  constexpr Font(const Glyph* glyphs, std::size_t glyph_count,
+                 const std::uint8_t* data, const Kerning* kerning,
+                 std::size_t kerning_count, const std::uint16_t* ascii,
+                 std::int32_t pages, std::int32_t blank)
+      : glyphs_(glyphs),
+        glyph_count_(glyph_count),
+        data_(data),
+        kerning_(kerning),
+        kerning_count_(kerning_count),
+        ascii_(ascii),
+        pages_(pages),
+        blank_(blank) {}
+
+  [[nodiscard]] constexpr std::int32_t pages() const { return pages_; }
+  [[nodiscard]] constexpr std::int32_t height() const { return pages_ * 8; }
+  [[nodiscard]] constexpr std::int32_t blank() const { return blank_; }
+  [[nodiscard]] constexpr std::size_t size() const { return glyph_count_; }
+
+  /**
+   * @brief 查找码位对应的字形
+   *
+   * @return const Glyph* 不存在时返回 nullptr
+   */
+  [[nodiscard]] constexpr const Glyph* find(char32_t codepoint) const {
+    if (codepoint < 128 && ascii_ != nullptr) {
+      auto index = ascii_[codepoint];
+      return index == NONE ? nullptr : &glyphs_[index];
+    }
+    std::size_t lo = 0;
+    std::size_t hi = glyph_count_;
+    while (lo < hi) {
+      auto mid = lo + (hi - lo) / 2;
+      if (glyphs_[mid].codepoint < codepoint) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo < glyph_count_ && glyphs_[lo].codepoint == codepoint
+               ? &glyphs_[lo]
+               : nullptr;
+  }
+
+  [[nodiscard]] constexpr Bitmap bitmap(const Glyph& glyph) const {
+    return {data_ + glyph.offset, glyph.width, glyph.pages};
+  }
+
+  /**
+   * @brief 字形对 (left, right) 之间的字距调整
+   */
+  [[nodiscard]] constexpr std::int32_t kerning(char32_t left,
+                                               char32_t right) const {
+    std::size_t lo = 0;
+    std::size_t hi = kerning_count_;
+    while (lo < hi) {
+      auto mid = lo + (hi - lo) / 2;
+      const auto& pair = kerning_[mid];
+      if (pair.left < left || (pair.left == left && pair.right < right)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    if (lo < kerning_count_ && kerning_[lo].left == left &&
+        kerning_[lo].right == right) {
+      return kerning_[lo].adjust;
+    }
+    return 0;
+  }
+
+  /**
+   * @brief 码位占用的宽度，不含字距调整
+   */
+  [[nodiscard]] constexpr std::int32_t advance(char32_t codepoint) const {
+    const auto* glyph = find(codepoint);
+    return glyph != nullptr ? glyph->advance : blank_;
+  }
+};
+
+/**
+ * @brief UTF-8 文本的总宽度，包含字距调整
+ *
+ * @param font Font 或其他提供 find、kerning 与 blank 的字体（如 FlashFont）
+ */
+template <typename Fo>
+constexpr std::int32_t measure(Fo& font, std::string_view text) {
+  std::int32_t width = 0;
+  char32_t previous = 0;
+  while (!text.empty()) {
+    auto codepoint = next_codepoint(text);
+    width += font.kerning(previous, codepoint);
+    const auto* glyph = font.find(codepoint);
+    width += glyph != nullptr ? glyph->advance : font.blank();
+    previous = codepoint;
+  }
+  return width;
+}
+
+}  // namespace SSDUI::Graphics
@@ -0,0 +1,366 @@
+#pragma once
+
+/**
+ *  编译期字体生成
+ *
+ *  从等宽的页格式字库（例如常见的 8x16 ASCII 字库）生成 Font 所需的表：
+ *  1. 只保留 Charset 中出现的字符，其余字形不进入 flash；
+ *  2. 去掉每个字形四周的空白列与空白页，只保存墨迹部分；
+ *  3. 可选地改为比例字体，前进宽度为墨迹宽度加字间距；
+ *  4. 附加字距调整表，两个字符都被保留的条目才会保留。
+ *
+ *  用法：
+ *    inline constexpr std::uint8_t raw[] = {...};
+ *    inline constexpr auto storage =
+ *        compile_font<"0123456789:", MonoSource{raw, 8, 2, ' ', '~'}>();
+ *    inline constexpr Font font = storage.font();
+ *
+ *  compile_font 以字符串字面量与结构体作为模板参数（类类型的非类型模板参数），
+ *  GCC 12 之前（包括 ESP32 的工具链）无法编译，此时 SSDUI_HAS_CLASS_NTTP
+ *  为 0，compile_font 不可用。build_font 以函数参数代替，不依赖这一特性，
+ *  表的大小由 font_glyphs、font_bytes 与 font_pairs 在编译期算出：
+ *    inline constexpr std::string_view charset = "0123456789:";
+ *    inline constexpr MonoSource source{raw, 8, 2, ' ', '~'};
+ *    inline constexpr auto storage =
+ *        build_font<font_glyphs(charset, source), font_bytes(charset, source)>(
+ *            charset, source);
+ *
+ *  不同字号使用不同的源字库分别生成，每个 Font 记录自己的行高。
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "ssdui/common/span.hh"
+#include "ssdui/graphics/font.hh"
+
+#ifndef SSDUI_HAS_CLASS_NTTP
+#if defined(__cpp_nontype_template_args) &&   \
+    __cpp_nontype_template_args >= 201911L && \
+    (defined(__clang__) || !defined(__GNUC__) || __GNUC__ >= 12)
+#define SSDUI_HAS_CLASS_NTTP 1
+#else
+#define SSDUI_HAS_CLASS_NTTP 0
+#endif
+#endif
+
+namespace SSDUI::Graphics {
+
+/**
+ * @brief 可作为模板参数的字符串字面量
+ */
+template <std::size_t N>
+struct FixedString {
+  char chars[N]{};
+
+  constexpr FixedString(const char (&str)[N]) {  // NOLINT
+    std::copy(str, str + N, chars);
+  }
+
+  [[nodiscard]] constexpr std::size_t size() const { return N - 1; }
+  constexpr char operator[](std::size_t index) const { return chars[index]; }
+
+  [[nodiscard]] constexpr std::string_view view() const {
+    return {chars, N - 1};
+  }
+};
+
+/**
+ * @brief 等宽的页格式源字库，从 first 到 last 连续存放
+ *        data 需要指向 constexpr 数组
+ */
+struct MonoSource {
+  const std::uint8_t* data;
+  std::int32_t width;
+  std::int32_t pages;
+  char32_t first;
+  char32_t last;
+};
+
+struct FontOptions {
+  /**
+   * @brief 是否生成比例字体，否则前进宽度为源字库的宽度
+   */
+  bool proportional{false};
+
+  /**
+   * @brief 比例字体的字间距
+   */
+  std::uint8_t spacing{1};
+
+  /**
+   * @brief 比例字体中空白字形（如空格）的宽度，为 0 时取源宽度的一半
+   */
+  std::uint8_t space{0};
+};
+
+/**
+ * @brief compile_font 生成的表，应当以 constexpr 变量保存
+ */
+template <std::size_t Glyphs, std::size_t Bytes, std::size_t Pairs>
+struct StaticFont {
+  std::array<Glyph, Glyphs> glyphs{};
+  std::array<std::uint8_t, Bytes> data{};
+  std::array<Kerning, Pairs> kerning{};
+  std::array<std::uint16_t, 128> ascii{};
+  std::int32_t pages{0};
+  std::int32_t blank{0};
+
+  [[nodiscard]] constexpr Font font() const {
+    return {glyphs.data(),  Glyphs, data.data(), kerning.data(),
+            Pairs,          ascii.data(), pages,       blank};
+  }
+};
+
+namespace Detail {
+
+/**
+ * @brief 字形墨迹所在的列 [left, right) 与页 [top, bottom)
+ */
+struct Extent {
+  std::int32_t left;
+  std::int32_t right;
+  std::int32_t top;
+  std::int32_t bottom;
+
+  [[nodiscard]] constexpr bool empty() const { return left >= right; }
+  [[nodiscard]] constexpr std::size_t size() const {
+    return empty() ? 0
+                   : static_cast<std::size_t>((right - left) * (bottom - top));
+  }
+};
+
+constexpr bool contains(const MonoSource& source, char32_t codepoint) {
+  return codepoint >= source.first && codepoint <= source.last;
+}
+
+constexpr std::uint8_t source_at(const MonoSource& source, char32_t codepoint,
+                                 std::int32_t x, std::int32_t page) {
+  auto base = static_cast<std::int32_t>(codepoint - source.first) *
+              source.width * source.pages;
+  return source.data[base + page * source.width + x];
+}
+
+constexpr Extent extent(const MonoSource& source, char32_t codepoint) {
+  Extent extent{source.width, 0, source.pages, 0};
+  for (std::int32_t page = 0; page < source.pages; page++) {
+    for (std::int32_t x = 0; x < source.width; x++) {
+      if (source_at(source, codepoint, x, page) != 0) {
+        extent.left = std::min(extent.left, x);
+        extent.right = std::max(extent.right, x + 1);
+        extent.top = std::min(extent.top, page);
+        extent.bottom = std::max(extent.bottom, page + 1);
+      }
+    }
+  }
+  return extent;
+}
+
+constexpr char32_t codepoint_at(std::string_view charset, std::size_t index) {
+  return static_cast<char32_t>(static_cast<unsigned char>(charset[index]));
+}
+
+/**
+ * @brief charset 中第 index 个字符是否需要保留：被源字库包含且第一次出现
+ */
+constexpr bool kept(std::string_view charset, const MonoSource& source,
+                    std::size_t index) {
+  if (!contains(source, codepoint_at(charset, index))) {
+    return false;
+  }
+  for (std::size_t i = 0; i < index; i++) {
+    if (charset[i] == charset[index]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 插入排序，表很小；std::sort 在 GCC 10 之前不能在编译期调用
+ */
+template <typename T, typename Less>
+constexpr void insertion_sort(T* first, T* last, Less less) {
+  for (auto* i = first; i != last; ++i) {
+    auto value = *i;
+    auto* j = i;
+    for (; j != first && less(value, *(j - 1)); --j) {
+      *j = *(j - 1);
+    }
+    *j = value;
+  }
+}
+
+/**
+ * @brief 保留的字符，升序排列
+ */
+template <std::size_t N>
+constexpr std::array<char32_t, N> subset(std::string_view charset,
+                                         const MonoSource& source) {
+  std::array<char32_t, N> codepoints{};
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < charset.size() && count < N; i++) {
+    if (kept(charset, source, i)) {
+      codepoints[count++] = codepoint_at(charset, i);
+    }
+  }
+  insertion_sort(codepoints.data(), codepoints.data() + N,
+                 [](char32_t lhs, char32_t rhs) { return lhs < rhs; });
+  return codepoints;
+}
+
+constexpr bool kept_pair(std::string_view charset, const MonoSource& source,
+                         const Kerning& pair) {
+  auto keeps = [&](char32_t codepoint) {
+    for (std::size_t i = 0; i < charset.size(); i++) {
+      if (codepoint_at(charset, i) == codepoint &&
+          contains(source, codepoint)) {
+        return true;
+      }
+    }
+    return false;
+  };
+  return keeps(pair.left) && keeps(pair.right);
+}
+
+}  // namespace Detail
+
+/**
+ * @brief 字体中的字形数：charset 中被源字库包含的字符，重复的只计一次
+ */
+constexpr std::size_t font_glyphs(std::string_view charset,
+                                  const MonoSource& source) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < charset.size(); i++) {
+    count += Detail::kept(charset, source, i) ? 1 : 0;
+  }
+  return count;
+}
+
+/**
+ * @brief 字体中字形数据的字节数
+ */
+constexpr std::size_t font_bytes(std::string_view charset,
+                                 const MonoSource& source) {
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < charset.size(); i++) {
+    if (Detail::kept(charset, source, i)) {
+      size += Detail::extent(source, Detail::codepoint_at(charset, i)).size();
+    }
+  }
+  return size;
+}
+
+/**
+ * @brief 字体中保留的字距调整条目数
+ */
+constexpr std::size_t font_pairs(std::string_view charset,
+                                 const MonoSource& source,
+                                 std::span<const Kerning> pairs) {
+  std::size_t count = 0;
+  for (const auto& pair : pairs) {
+    count += Detail::kept_pair(charset, source, pair) ? 1 : 0;
+  }
+  return count;
+}
+
+/**
+ * @brief 在编译期从源字库生成字体，不需要类类型的模板参数
+ *
+ * @tparam Glyphs 字形数，应当为 font_glyphs(charset, source)
+ * @tparam Bytes 字形数据的字节数，应当为 font_bytes(charset, source)
+ * @tparam Pairs 字距调整条目数，应当为 font_pairs(charset, source, pairs)
+ * @param charset 需要保留的字符
+ * @param source 源字库
+ * @param options 生成选项
+ * @param pairs 字距调整，顺序任意
+ */
+template <std::size_t Glyphs, std::size_t Bytes, std::size_t Pairs = 0>
+constexpr StaticFont<Glyphs, Bytes, Pairs> build_font(
+    std::string_view charset, const MonoSource& source,
+    FontOptions options = {}, std::span<const Kerning> pairs = {}) {
+  auto codepoints = Detail::subset<Glyphs>(charset, source);
+
+  StaticFont<Glyphs, Bytes, Pairs> font{};
+  font.pages = source.pages;
+  auto space = options.space != 0 ? options.space : source.width / 2;
+  font.blank = options.proportional ? space : source.width;
+  // std::array::fill 在 GCC 10 之前不能在编译期调用
+  for (auto& index : font.ascii) {
+    index = Font::NONE;
+  }
+
+  std::uint32_t offset = 0;
+  for (std::size_t i = 0; i < codepoints.size(); i++) {
+    auto c = codepoints[i];
+    auto extent = Detail::extent(source, c);
+    auto& glyph = font.glyphs[i];
+    glyph.codepoint = c;
+    glyph.offset = offset;
+
+    if (extent.empty()) {
+      glyph.advance = static_cast<std::uint8_t>(font.blank);
+    } else {
+      glyph.width = static_cast<std::uint8_t>(extent.right - extent.left);
+      glyph.pages = static_cast<std::uint8_t>(extent.bottom - extent.top);
+      glyph.top = static_cast<std::uint8_t>(extent.top);
+      if (options.proportional) {
+        glyph.advance =
+            static_cast<std::uint8_t>(glyph.width + options.spacing);
+      } else {
+        glyph.left = static_cast<std::int8_t>(extent.left);
+        glyph.advance = static_cast<std::uint8_t>(source.width);
+      }
+      for (auto page = extent.top; page < extent.bottom; page++) {
+        for (auto x = extent.left; x < extent.right; x++) {
+          font.data[offset++] = Detail::source_at(source, c, x, page);
+        }
+      }
+    }
+    if (c < 128) {
+      font.ascii[c] = static_cast<std::uint16_t>(i);
+    }
+  }
+
+  std::size_t count = 0;
+  for (const auto& pair : pairs) {
+    if (count < Pairs && Detail::kept_pair(charset, source, pair)) {
+      font.kerning[count++] = pair;
+    }
+  }
+  Detail::insertion_sort(font.kerning.data(), font.kerning.data() + Pairs,
+                         [](const Kerning& lhs, const Kerning& rhs) {
+                           return lhs.left != rhs.left
+                                      ? lhs.left < rhs.left
+                                      : lhs.right < rhs.right;
+                         });
+  return font;
+}
+
+#if SSDUI_HAS_CLASS_NTTP
+
+/**
+ * @brief 在编译期从源字库生成字体，表的大小由模板参数推导
+ *        需要类类型的非类型模板参数（GCC >= 12）
+ *
+ * @tparam Charset 需要保留的字符
+ * @tparam Source 源字库
+ * @tparam Options 生成选项
+ * @tparam Pairs 字距调整，顺序任意
+ */
+template <FixedString Charset, MonoSource Source,
+          FontOptions Options = FontOptions{},
+          std::array Pairs = std::array<Kerning, 0>{}>
+constexpr auto compile_font() {
+  constexpr auto charset = Charset.view();
+  return build_font<font_glyphs(charset, Source), font_bytes(charset, Source),
+                    font_pairs(charset, Source, Pairs)>(charset, Source,
+                                                        Options, Pairs);
+}
+
+#endif
+
+}  // namespace SSDUI::Graphics
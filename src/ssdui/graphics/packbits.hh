@@ -0,0 +1,117 @@
+#pragma once
+
+/**
+ *  PackBits 游程编码
+ *
+ *  控制字节 n < 128 时，其后 n + 1 个字节原样输出；
+ *  n >= 128 时，其后的一个字节重复 n - 125 次（3 到 130 次）。
+ *
+ *  PackBitsReader 按需流式解码，不需要完整的输出缓冲：
+ *  调用者每次取出若干字节，以原样片段或重复值的形式交给回调处理，
+ *  可以把数据直接合成到目标上；不需要的部分可以跳过而不展开。
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "ssdui/common/span.hh"
+
+namespace SSDUI::Graphics {
+
+class PackBitsReader {
+ private:
+  const std::uint8_t* data_{nullptr};
+  std::size_t size_{0};
+  std::size_t position_{0};
+
+  /**
+   * @brief 当前控制字节剩余的原样字节数或重复次数
+   */
+  std::size_t literal_{0};
+  std::size_t repeat_{0};
+  std::uint8_t value_{0};
+
+  /**
+   * @brief 读取下一个控制字节，输入耗尽或损坏时返回 false
+   */
+  bool _fetch() {
+    if (position_ >= size_) {
+      return false;
+    }
+    auto control = data_[position_++];
+    if (control < 128) {
+      literal_ = control + 1U;
+      // 截断的原样片段只保留实际存在的部分
+      literal_ = std::min(literal_, size_ - position_);
+      return literal_ != 0;
+    }
+    if (position_ >= size_) {
+      return false;
+    }
+    repeat_ = control - 125U;
+    value_ = data_[position_++];
+    return true;
+  }
+
+ public:
+  PackBitsReader() = default;
+  PackBitsReader(const std::uint8_t* data, std::size_t size)
+      : data_(data), size_(size) {}
+
+  /**
+   * @brief 取出 count 个字节，依次以片段交给 fn
+   *
+   * @param count 字节数
+   * @param fn 回调 fn(offset, bytes, value, n)：offset 为片段在本次取出的
+   *           字节中的位置；bytes 不为空时片段为 bytes[0, n)，否则为 n 个 value
+   * @return bool 输入提前耗尽时返回 false
+   */
+  template <typename Fn>
+  bool read(std::size_t count, Fn&& fn) {
+    std::size_t offset = 0;
+    while (offset < count) {
+      if (repeat_ == 0 && literal_ == 0 && !_fetch()) {
+        return false;
+      }
+      auto rest = count - offset;
+      if (repeat_ != 0) {
+        auto n = std::min(repeat_, rest);
+        fn(offset, static_cast<const std::uint8_t*>(nullptr), value_, n);
+        repeat_ -= n;
+        offset += n;
+      } else {
+        auto n = std::min(literal_, rest);
+        fn(offset, data_ + position_, std::uint8_t{0}, n);
+        position_ += n;
+        literal_ -= n;
+        offset += n;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief 解码到 out，写满时返回 true
+   */
+  bool read(std::span<std::uint8_t> out) {
+    return read(out.size(), [&](std::size_t offset, const std::uint8_t* bytes,
+                                std::uint8_t value, std::size_t n) {
+      if (bytes != nullptr) {
+        std::copy(bytes, bytes + n, out.data() + offset);
+      } else {
+        std::fill(out.data() + offset, out.data() + offset + n, value);
+      }
+    });
+  }
+
+  /**
+   * @brief 跳过 count 个字节，不展开
+   */
+  bool skip(std::size_t count) {
+    return read(count, [](std::size_t, const std::uint8_t*, std::uint8_t,
+                          std::size_t) {});
+  }
+};
+
+}  // namespace SSDUI::Graphics
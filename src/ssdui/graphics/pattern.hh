@@ -0,0 +1,124 @@
+#pragma once
+
+/**
+ *  8x8 填充图案
+ *
+ *  单色屏上的灰度与阴影靠图案表现。图案与 Surface 相同为页格式：
+ *  每列一个字节，第 y 位为第 y % 8 行，因此填充时每列只需把本页的掩码与
+ *  对应列的图案字节相与，开销与纯色填充相同，不逐像素判断。
+ *
+ *  图案以绘制坐标为基准平铺（第 x % 8 列、第 y % 8 行），
+ *  相邻的图形、离屏目标与旋转的表面上的图案可以无缝拼接。
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace SSDUI::Graphics {
+
+namespace Detail {
+
+/**
+ * @brief 8x8 Bayer 矩阵第 y 行第 x 列的值（0 到 63）：
+ *        x ^ y 与 y 的各位交错后反转，相邻的值在平面上尽量分散
+ */
+constexpr std::int32_t bayer(std::int32_t x, std::int32_t y) {
+  std::int32_t value = 0;
+  for (std::int32_t i = 0; i < 3; i++) {
+    value |= (((x ^ y) >> i) & 1) << (5 - 2 * i);
+    value |= ((y >> i) & 1) << (4 - 2 * i);
+  }
+  return value;
+}
+
+}  // namespace Detail
+
+struct Pattern {
+  /**
+   * @brief 第 x % 8 列的字节，第 y 位为第 y % 8 行
+   */
+  std::array<std::uint8_t, 8> columns{};
+
+  /**
+   * @brief 8x8 Bayer 有序抖动的灰度
+   *
+   * @param level 点亮的像素数（0 到 64），按 Bayer 矩阵的顺序点亮，
+   *              相邻的等级只差一个像素，点亮的像素尽量均匀分散
+   */
+  static constexpr Pattern gray(std::int32_t level) {
+    Pattern pattern;
+    for (std::int32_t x = 0; x < 8; x++) {
+      for (std::int32_t y = 0; y < 8; y++) {
+        if (Detail::bayer(x, y) < level) {
+          pattern.columns[x] |= static_cast<std::uint8_t>(1U << y);
+        }
+      }
+    }
+    return pattern;
+  }
+
+  static constexpr Pattern solid() { return gray(64); }
+
+  /**
+   * @brief 每 4 行一条横线
+   */
+  static constexpr Pattern horizontal() {
+    return {{0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11}};
+  }
+
+  /**
+   * @brief 每 4 列一条竖线
+   */
+  static constexpr Pattern vertical() {
+    return {{0xFF, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00}};
+  }
+
+  /**
+   * @brief 左上到右下的斜线（\），间隔 4 像素
+   */
+  static constexpr Pattern diagonal() {
+    return {{0x11, 0x22, 0x44, 0x88, 0x11, 0x22, 0x44, 0x88}};
+  }
+
+  /**
+   * @brief 左下到右上的斜线（/），间隔 4 像素
+   */
+  static constexpr Pattern anti_diagonal() {
+    return {{0x11, 0x88, 0x44, 0x22, 0x11, 0x88, 0x44, 0x22}};
+  }
+
+  /**
+   * @brief 横竖交叉的网格
+   */
+  static constexpr Pattern grid() { return horizontal() | vertical(); }
+
+  /**
+   * @brief 两个方向的斜线交叉
+   */
+  static constexpr Pattern crosshatch() {
+    return diagonal() | anti_diagonal();
+  }
+
+  constexpr Pattern operator|(const Pattern& rhs) const {
+    Pattern pattern;
+    for (std::size_t i = 0; i < 8; i++) {
+      pattern.columns[i] = columns[i] | rhs.columns[i];
+    }
+    return pattern;
+  }
+
+  constexpr Pattern operator~() const {
+    Pattern pattern;
+    for (std::size_t i = 0; i < 8; i++) {
+      pattern.columns[i] = static_cast<std::uint8_t>(~columns[i]);
+    }
+    return pattern;
+  }
+
+  constexpr bool operator==(const Pattern& rhs) const {
+    return columns == rhs.columns;
+  }
+};
+
+}  // namespace SSDUI::Graphics
@@ -0,0 +1,267 @@
+#pragma once
+
+/**
+ *  多边形的扫描线填充
+ *
+ *  顶点为 24.8 定点坐标，整数部分为像素的角点：像素 (x, y) 的中心为
+ *  (x + 0.5, y + 0.5)，中心落在多边形内即点亮，与 Rect 覆盖 [x, x + w) 一致。
+ *
+ *  经典的活动边表：边按起始行排序，逐行把开始的边加入活动表、移除结束的边，
+ *  交点的 x 为 16.16 定点，每行只加一次斜率；活动表按 x 排序后按填充规则
+ *  成对输出水平区间。只扫描 [row0, row1) 内的行，裁剪区域以外的行不计算。
+ *
+ *  边表为定长数组，不分配内存，顶点数不超过 MAX_POLYGON_VERTICES。
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "ssdui/common/span.hh"
+#include "ssdui/geometry/point.hh"
+
+namespace SSDUI::Graphics {
+
+/**
+ * @brief 填充规则
+ */
+enum class FillRule : std::uint8_t {
+  /**
+   * @brief 穿过奇数条边的区域在内部，自相交的部分镂空
+   */
+  EvenOdd,
+  /**
+   * @brief 环绕数不为 0 的区域在内部
+   */
+  NonZero,
+};
+
+inline constexpr std::size_t MAX_POLYGON_VERTICES = 32;
+
+/**
+ * @brief 顶点定点坐标的小数位数
+ */
+inline constexpr int POLYGON_SHIFT = 8;
+
+namespace Detail {
+
+struct PolygonEdge {
+  /**
+   * @brief 当前行的交点与每行的增量，16.16 定点
+   */
+  std::int32_t x;
+  std::int32_t slope;
+
+  /**
+   * @brief 覆盖的行 [first, last)
+   */
+  std::int32_t first;
+  std::int32_t last;
+
+  /**
+   * @brief 上端点，24.8 定点，用于在任意一行开始时求交点
+   */
+  std::int32_t x0;
+  std::int32_t y0;
+
+  std::int32_t winding;
+};
+
+/**
+ * @brief 24.8 定点的 y 之后（含）第一个像素中心所在的行
+ */
+constexpr std::int32_t polygon_row(std::int32_t y) {
+  return (y - (1 << (POLYGON_SHIFT - 1)) + (1 << POLYGON_SHIFT) - 1) >>
+         POLYGON_SHIFT;
+}
+
+/**
+ * @brief 16.16 定点的 x 之后（含）第一个像素中心所在的列
+ */
+constexpr std::int32_t polygon_column(std::int32_t x) {
+  return (x + 0x7FFF) >> 16;
+}
+
+constexpr std::uint64_t isqrt(std::uint64_t value) {
+  std::uint64_t root = 0;
+  std::uint64_t bit = 1ULL << 62;
+  while (bit > value) {
+    bit >>= 2;
+  }
+  while (bit != 0) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
+}  // namespace Detail
+
+/**
+ * @brief 扫描多边形，逐行输出内部的水平区间
+ *
+ * @param points 顶点，24.8 定点，首尾自动相连
+ * @param rule 填充规则
+ * @param row0 第一行
+ * @param row1 最后一行之后
+ * @param fn 回调 fn(x0, x1, y)，输出像素区间 [x0, x1) x y，同一行从左到右
+ * @return bool 顶点数超过 MAX_POLYGON_VERTICES 时不扫描并返回 false
+ */
+template <typename Fn>
+bool scan_polygon(std::span<const Geometry::Point<std::int32_t>> points,
+                  FillRule rule, std::int32_t row0, std::int32_t row1,
+                  Fn&& fn) {
+  if (points.size() > MAX_POLYGON_VERTICES) {
+    return false;
+  }
+
+  std::array<Detail::PolygonEdge, MAX_POLYGON_VERTICES> edges{};
+  std::size_t count = 0;
+  std::int32_t top = row1;
+  std::int32_t bottom = row0;
+  for (std::size_t i = 0; i < points.size(); i++) {
+    auto a = points[i];
+    auto b = points[i + 1 == points.size() ? 0 : i + 1];
+    std::int32_t winding = 1;
+    if (a.y > b.y) {
+      auto t = a;
+      a = b;
+      b = t;
+      winding = -1;
+    }
+    auto first = Detail::polygon_row(a.y);
+    auto last = Detail::polygon_row(b.y);
+    // 水平的边与不跨过像素中心的边不影响任何一行
+    if (first >= last) {
+      continue;
+    }
+    auto slope = (static_cast<std::int64_t>(b.x - a.x) << 16) / (b.y - a.y);
+
+    // 按起始行插入排序
+    auto j = count++;
+    for (; j > 0 && edges[j - 1].first > first; j--) {
+      edges[j] = edges[j - 1];
+    }
+    edges[j] = {0, static_cast<std::int32_t>(slope), first, last, a.x, a.y,
+                winding};
+    top = first < top ? first : top;
+    bottom = last > bottom ? last : bottom;
+  }
+
+  row0 = top > row0 ? top : row0;
+  row1 = bottom < row1 ? bottom : row1;
+
+  std::array<Detail::PolygonEdge*, MAX_POLYGON_VERTICES> active{};
+  std::size_t actives = 0;
+  std::size_t next = 0;
+  for (auto y = row0; y < row1; y++) {
+    // 移除已经结束的边
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < actives; i++) {
+      if (active[i]->last > y) {
+        active[kept++] = active[i];
+      }
+    }
+    actives = kept;
+
+    // 加入从这一行（或裁剪区域之上）开始的边，交点直接求出
+    for (; next < count && edges[next].first <= y; next++) {
+      auto& edge = edges[next];
+      if (edge.last <= y) {
+        continue;
+      }
+      auto center = (y << POLYGON_SHIFT) + (1 << (POLYGON_SHIFT - 1));
+      edge.x = static_cast<std::int32_t>(
+          (static_cast<std::int64_t>(edge.x0) << (16 - POLYGON_SHIFT)) +
+          ((static_cast<std::int64_t>(edge.slope) * (center - edge.y0)) >>
+           POLYGON_SHIFT));
+      active[actives++] = &edge;
+    }
+
+    // 交点的顺序在相邻两行之间很少变化，插入排序接近线性
+    for (std::size_t i = 1; i < actives; i++) {
+      auto* edge = active[i];
+      auto j = i;
+      for (; j > 0 && active[j - 1]->x > edge->x; j--) {
+        active[j] = active[j - 1];
+      }
+      active[j] = edge;
+    }
+
+    if (rule == FillRule::EvenOdd) {
+      for (std::size_t i = 0; i + 1 < actives; i += 2) {
+        auto x0 = Detail::polygon_column(active[i]->x);
+        auto x1 = Detail::polygon_column(active[i + 1]->x);
+        if (x0 < x1) {
+          fn(x0, x1, y);
+        }
+      }
+    } else {
+      std::int32_t winding = 0;
+      std::int32_t x0 = 0;
+      for (std::size_t i = 0; i < actives; i++) {
+        if (winding == 0) {
+          x0 = Detail::polygon_column(active[i]->x);
+        }
+        winding += active[i]->winding;
+        if (winding == 0) {
+          auto x1 = Detail::polygon_column(active[i]->x);
+          if (x0 < x1) {
+            fn(x0, x1, y);
+          }
+        }
+      }
+    }
+
+    for (std::size_t i = 0; i < actives; i++) {
+      active[i]->x += active[i]->slope;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 有宽度的线段的轮廓，端点为像素中心，两端各延长宽度的一半（方头），
+ *        宽度为 1 的水平或竖直线段与 Surface::line 覆盖相同的像素
+ *
+ * @return std::array 四个顶点，24.8 定点
+ */
+constexpr std::array<Geometry::Point<std::int32_t>, 4> stroke_outline(
+    Geometry::Point<std::int32_t> start, Geometry::Point<std::int32_t> end,
+    std::int32_t width) {
+  constexpr std::int32_t ONE = 1 << POLYGON_SHIFT;
+  Geometry::Point<std::int32_t> a{start.x * ONE + ONE / 2,
+                                  start.y * ONE + ONE / 2};
+  Geometry::Point<std::int32_t> b{end.x * ONE + ONE / 2, end.y * ONE + ONE / 2};
+  auto dx = static_cast<std::int64_t>(b.x - a.x);
+  auto dy = static_cast<std::int64_t>(b.y - a.y);
+  auto length = static_cast<std::int64_t>(
+      Detail::isqrt(static_cast<std::uint64_t>(dx * dx + dy * dy)));
+  auto half = static_cast<std::int64_t>(width) * ONE / 2;
+
+  // 沿线段方向与法线方向各偏移半个宽度，长度为 0 时为正方形
+  std::int32_t ax = 0;
+  std::int32_t ay = 0;
+  std::int32_t nx = 0;
+  std::int32_t ny = 0;
+  if (length == 0) {
+    ax = static_cast<std::int32_t>(half);
+    ny = static_cast<std::int32_t>(half);
+  } else {
+    ax = static_cast<std::int32_t>(dx * half / length);
+    ay = static_cast<std::int32_t>(dy * half / length);
+    nx = -ay;
+    ny = ax;
+  }
+  return {{{a.x - ax + nx, a.y - ay + ny},
+           {b.x + ax + nx, b.y + ay + ny},
+           {b.x + ax - nx, b.y + ay - ny},
+           {a.x - ax - nx, a.y - ay - ny}}};
+}
+
+}  // namespace SSDUI::Graphics
@@ -0,0 +1,1415 @@
+#pragma once
+
+/**
+ *  绘制表面
+ *
+ *  Surface 是对一块页格式像素数据的视图：
+ *  每个字节表示一列中竖直方向的 8 个像素，低位在上；
+ *  字节按页优先排列，第 page 页第 x 列位于 data[x + page * width]。
+ *  这与 SSD1306 显存的格式相同，也与 Context::Buffer 相同。
+ *
+ *  所有图元都以“区间”为单位绘制：先与裁剪区域求交一次，
+ *  再对区间内的字节整体写入掩码，不对每个像素做边界检查。
+ *
+ *  带有显示列表的表面不光栅化，而是把图元追加到列表中（plot 与 at 除外）。
+ *
+ *  表面可以只覆盖绘制坐标系中的一部分（离屏目标），origin 为其左上角的坐标；
+ *  图元与裁剪区域都使用绘制坐标，组件不需要关心自己画在屏幕上还是离屏目标上。
+ *
+ *  旋转 90 或 270 度的表面（竖装的屏幕）对外使用旋转后的逻辑坐标，
+ *  宽高与存储相反。图元在写入前换算到存储坐标：水平与竖直区间互换，
+ *  矩形仍按页填充；位图按 8x8 的块转置（transpose.hh）后按页合成，
+ *  不逐像素换算。
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "ssdui/common/span.hh"
+#include "ssdui/graphics/bitmap.hh"
+#include "ssdui/graphics/display_list.hh"
+#include "ssdui/graphics/ellipse.hh"
+#include "ssdui/graphics/packbits.hh"
+#include "ssdui/graphics/pattern.hh"
+#include "ssdui/graphics/polygon.hh"
+#include "ssdui/graphics/transpose.hh"
+#include "ssdui/geometry/line.hh"
+#include "ssdui/geometry/point.hh"
+#include "ssdui/geometry/rectangle.hh"
+
+namespace SSDUI::Graphics {
+
+using Rect = Geometry::Rectangle<std::int32_t>;
+using Vec = Geometry::Point<std::int32_t>;
+
+/**
+ * @brief 一页内 [top, bottom) 行对应的掩码，0 <= top < bottom <= 8
+ */
+constexpr std::uint8_t page_mask(std::int32_t top, std::int32_t bottom) {
+  return static_cast<std::uint8_t>((0xFFU << top) & (0xFFU >> (8 - bottom)));
+}
+
+/**
+ * @brief 逻辑坐标相对于存储的旋转方向（顺时针）
+ */
+enum class Rotation : std::uint8_t {
+  None,
+  /**
+   * @brief 逻辑 (x, y) 位于存储的 (width - 1 - y, x)
+   */
+  Clockwise90,
+  /**
+   * @brief 逻辑 (x, y) 位于存储的 (y, height - 1 - x)
+   */
+  Clockwise270,
+};
+
+/**
+ * @brief 逻辑坐标中的矩形在存储中覆盖的矩形
+ *
+ * @param rect 矩形，相对于存储左上角
+ * @param rotation 旋转方向
+ * @param width 存储的宽度
+ * @param height 存储的高度
+ */
+constexpr Rect rotate(const Rect& rect, Rotation rotation, std::int32_t width,
+                      std::int32_t height) {
+  switch (rotation) {
+    case Rotation::None:
+      break;
+    case Rotation::Clockwise90:
+      return {{width - rect.origin.y - rect.size.y, rect.origin.x},
+              {rect.size.y, rect.size.x}};
+    case Rotation::Clockwise270:
+      return {{rect.origin.y, height - rect.origin.x - rect.size.x},
+              {rect.size.y, rect.size.x}};
+  }
+  return rect;
+}
+
+class Surface {
+ private:
+  std::uint8_t* data_;
+  std::int32_t width_;
+  std::int32_t pages_;
+
+  /**
+   * @brief 表面左上角在绘制坐标系中的位置
+   */
+  Vec origin_;
+
+  /**
+   * @brief 裁剪区域，绘制坐标，总在表面之内
+   */
+  Rect clip_;
+
+  /**
+   * @brief 录制目标，为空时直接光栅化
+   */
+  DisplayList* list_{nullptr};
+
+  Rotation rotation_{Rotation::None};
+
+  [[nodiscard]] bool _rotated() const { return rotation_ != Rotation::None; }
+
+  /**
+   * @brief 逻辑坐标的矩形换算为存储坐标
+   */
+  [[nodiscard]] Rect _map(const Rect& rect) const {
+    return rotate({rect.origin - origin_, rect.size}, rotation_, width_,
+                  pages_ * 8);
+  }
+
+  [[nodiscard]] Vec _map(Vec point) const {
+    return _map(Rect(point, {1, 1})).origin;
+  }
+
+  /**
+   * @brief 以存储坐标查看同一块数据，裁剪区域换算到存储坐标
+   */
+  [[nodiscard]] Surface _storage() const {
+    return {{data_, static_cast<std::size_t>(width_ * pages_)},
+            width_,
+            pages_,
+            _map(clip_)};
+  }
+
+ public:
+  /**
+   * @param data 页格式的像素数据，大小为 width * pages
+   * @param width 宽度
+   * @param pages 页数，高度为 pages * 8
+   * @param clip 裁剪区域，会被限制在表面之内
+   * @param list 录制目标，为空时直接光栅化
+   * @param origin 表面左上角在绘制坐标系中的位置
+   * @param rotation 逻辑坐标相对于存储的旋转，旋转 90 或 270 度时
+   *                 逻辑宽度为 pages * 8、高度为 width
+   */
+  Surface(std::span<std::uint8_t> data, std::int32_t width,
+          std::int32_t pages, Rect clip, DisplayList* list = nullptr,
+          Vec origin = {0, 0}, Rotation rotation = Rotation::None)
+      : data_(data.data()),
+        width_(width),
+        pages_(pages),
+        origin_(origin),
+        clip_(clip.intersection(
+            rotation == Rotation::None ? Rect(origin, {width, pages * 8})
+                                       : Rect(origin, {pages * 8, width}))),
+        list_(list),
+        rotation_(rotation) {}
+
+  Surface(std::span<std::uint8_t> data, std::int32_t width,
+          std::int32_t pages)
+      : Surface(data, width, pages, Rect({0, 0}, {width, pages * 8})) {}
+
+  /**
+   * @brief 存储的宽度、高度与页数，不考虑旋转
+   */
+  [[nodiscard]] std::int32_t width() const { return width_; }
+  [[nodiscard]] std::int32_t height() const { return pages_ * 8; }
+  [[nodiscard]] std::int32_t pages() const { return pages_; }
+  [[nodiscard]] const Rect& clip() const { return clip_; }
+  [[nodiscard]] const Vec& origin() const { return origin_; }
+  [[nodiscard]] Rotation rotation() const { return rotation_; }
+
+  /**
+   * @brief 表面在绘制坐标系中覆盖的区域
+   */
+  [[nodiscard]] Rect bounds() const {
+    return _rotated() ? Rect(origin_, {pages_ * 8, width_})
+                      : Rect(origin_, {width_, pages_ * 8});
+  }
+  [[nodiscard]] std::uint8_t* data() const { return data_; }
+
+  /**
+   * @brief 以另一个裁剪区域查看同一块数据，新区域与当前区域求交
+   */
+  [[nodiscard]] Surface clipped(const Rect& clip) const {
+    return {{data_, static_cast<std::size_t>(width_ * pages_)},
+            width_,
+            pages_,
+            clip_.intersection(clip),
+            list_,
+            origin_,
+            rotation_};
+  }
+
+  [[nodiscard]] bool recording() const { return list_ != nullptr; }
+
+  /**
+   * @brief 第 page 页第 x 列的字节，存储坐标，调用者保证坐标合法
+   */
+  [[nodiscard]] std::uint8_t& at(std::int32_t x, std::int32_t page) const {
+    return data_[x + page * width_];
+  }
+
+  /**
+   * @brief 点亮一个像素，调用者保证在裁剪区域内
+   */
+  void plot(std::int32_t x, std::int32_t y) const {
+    if (_rotated()) {
+      auto point = _map(Vec{x, y});
+      x = point.x;
+      y = point.y;
+    } else {
+      x -= origin_.x;
+      y -= origin_.y;
+    }
+    at(x, y >> 3) |= static_cast<std::uint8_t>(1U << (y & 7));
+  }
+
+  void pixel(std::int32_t x, std::int32_t y) const {
+    if (list_ != nullptr) {
+      list_->pixel(x, y);
+      return;
+    }
+    if (clip_.contains({x, y})) {
+      plot(x, y);
+    }
+  }
+
+  /**
+   * @brief 水平区间 [x0, x1) x y
+   */
+  void hspan(std::int32_t x0, std::int32_t x1, std::int32_t y) const {
+    if (list_ != nullptr) {
+      list_->hspan(x0, x1, y);
+      return;
+    }
+    if (_rotated()) {
+      // 旋转后为存储中的竖直区间
+      auto span = _map(Rect({x0, y}, {x1 - x0, 1}));
+      _storage().vspan(span.origin.x, span.origin.y,
+                       span.origin.y + span.size.y);
+      return;
+    }
+    if (y < clip_.origin.y || y >= clip_.origin.y + clip_.size.y) {
+      return;
+    }
+    x0 = x0 > clip_.origin.x ? x0 : clip_.origin.x;
+    x1 = x1 < clip_.origin.x + clip_.size.x ? x1
+                                            : clip_.origin.x + clip_.size.x;
+
+    y -= origin_.y;
+    auto mask = static_cast<std::uint8_t>(1U << (y & 7));
+    auto* row = data_ + (y >> 3) * width_ - origin_.x;
+    for (auto x = x0; x < x1; x++) {
+      row[x] |= mask;
+    }
+  }
+
+  /**
+   * @brief 竖直区间 x x [y0, y1)，每页只写一次
+   */
+  void vspan(std::int32_t x, std::int32_t y0, std::int32_t y1) const {
+    if (list_ != nullptr) {
+      list_->vspan(x, y0, y1);
+      return;
+    }
+    if (_rotated()) {
+      auto span = _map(Rect({x, y0}, {1, y1 - y0}));
+      _storage().hspan(span.origin.x, span.origin.x + span.size.x,
+                       span.origin.y);
+      return;
+    }
+    if (x < clip_.origin.x || x >= clip_.origin.x + clip_.size.x) {
+      return;
+    }
+    y0 = y0 > clip_.origin.y ? y0 : clip_.origin.y;
+    y1 = y1 < clip_.origin.y + clip_.size.y ? y1
+                                            : clip_.origin.y + clip_.size.y;
+
+    x -= origin_.x;
+    y0 -= origin_.y;
+    y1 -= origin_.y;
+    for (auto y = y0; y < y1;) {
+      auto page = y >> 3;
+      auto bottom = (page + 1) * 8 < y1 ? (page + 1) * 8 : y1;
+      at(x, page) |= page_mask(y - page * 8, bottom - page * 8);
+      y = bottom;
+    }
+  }
+
+  /**
+   * @brief 填充矩形，每页计算一次掩码后按列写入
+   */
+  void fill(const Rect& rect) const {
+    if (list_ != nullptr) {
+      list_->fill(rect);
+      return;
+    }
+    _fill(rect, nullptr);
+  }
+
+  /**
+   * @brief 以图案填充矩形，只点亮图案中的像素
+   *        每页的掩码与各列的图案字节相与后写入，开销与纯色填充相同
+   */
+  void fill(const Rect& rect, const Pattern& pattern) const {
+    if (list_ != nullptr) {
+      list_->fill(rect, pattern);
+      return;
+    }
+    auto tile = _pattern(pattern);
+    _fill(rect, &tile);
+  }
+
+  /**
+   * @brief 矩形边框
+   */
+  void frame(const Rect& rect) const {
+    if (list_ != nullptr) {
+      list_->frame(rect);
+      return;
+    }
+    if (rect.empty()) {
+      return;
+    }
+    auto x1 = rect.origin.x + rect.size.x;
+    auto y1 = rect.origin.y + rect.size.y;
+    hspan(rect.origin.x, x1, rect.origin.y);
+    hspan(rect.origin.x, x1, y1 - 1);
+    vspan(rect.origin.x, rect.origin.y, y1);
+    vspan(x1 - 1, rect.origin.y, y1);
+  }
+
+  /**
+   * @brief 包含两端点的线段
+   *        水平与竖直线段按区间绘制；完全在裁剪区域内的斜线不做逐点检查
+   */
+  void line(const Geometry::Line<std::int32_t>& line) const {
+    if (list_ != nullptr) {
+      list_->line(line);
+      return;
+    }
+    if (_rotated()) {
+      // Bresenham 对坐标轴的交换与翻转对称，旋转端点得到相同的像素
+      _storage().line({_map(line.start), _map(line.end)});
+      return;
+    }
+    auto [start, end] = line;
+    if (start.y == end.y) {
+      hspan(start.x < end.x ? start.x : end.x,
+            (start.x < end.x ? end.x : start.x) + 1, start.y);
+      return;
+    }
+    if (start.x == end.x) {
+      vspan(start.x, start.y < end.y ? start.y : end.y,
+            (start.y < end.y ? end.y : start.y) + 1);
+      return;
+    }
+
+    Rect bounds({start.x < end.x ? start.x : end.x,
+                 start.y < end.y ? start.y : end.y},
+                {(start.x < end.x ? end.x - start.x : start.x - end.x) + 1,
+                 (start.y < end.y ? end.y - start.y : start.y - end.y) + 1});
+    if (!bounds.intersects(clip_)) {
+      return;
+    }
+    if (bounds.intersection(clip_) == bounds) {
+      _bresenham(start, end, [this](auto x, auto y) { plot(x, y); });
+    } else {
+      _bresenham(start, end, [this](auto x, auto y) { pixel(x, y); });
+    }
+  }
+
+  /**
+   * @brief 内切于 box 的椭圆边框
+   *        每行只画与外侧一行不重叠的部分，陡峭处为单个像素，平缓处为一段
+   */
+  void ellipse(const Rect& box) const {
+    if (list_ != nullptr) {
+      list_->ellipse(box);
+      return;
+    }
+    if (box.intersects(clip_)) {
+      _rounded(box, box.size, false, nullptr, nullptr);
+    }
+  }
+
+  /**
+   * @brief 填充内切于 box 的椭圆，每行一个水平区间
+   */
+  void fill_ellipse(const Rect& box) const {
+    if (list_ != nullptr) {
+      list_->fill_ellipse(box);
+      return;
+    }
+    if (box.intersects(clip_)) {
+      _rounded(box, box.size, true, nullptr, nullptr);
+    }
+  }
+
+  void fill_ellipse(const Rect& box, const Pattern& pattern) const {
+    if (list_ != nullptr) {
+      list_->fill_ellipse(box, pattern);
+      return;
+    }
+    if (box.intersects(clip_)) {
+      auto tile = _pattern(pattern);
+      _rounded(box, box.size, true, nullptr, &tile);
+    }
+  }
+
+  /**
+   * @brief 圆心为 center、半径为 radius 的圆，直径为 2 * radius + 1
+   */
+  void circle(Vec center, std::int32_t radius) const {
+    ellipse(_circle_box(center, radius));
+  }
+
+  void fill_circle(Vec center, std::int32_t radius) const {
+    fill_ellipse(_circle_box(center, radius));
+  }
+
+  /**
+   * @brief 内切于 box 的椭圆上的一段弧
+   *        thickness 大于 1 时为两个椭圆之间的环形，
+   *        不小于半径时为扇形
+   *
+   * @param box 外侧椭圆的包围盒
+   * @param start 起始角度（度），0 度指向右侧，顺时针增加
+   * @param sweep 扫过的角度，负数为逆时针
+   * @param thickness 向内的宽度
+   */
+  void arc(const Rect& box, std::int32_t start, std::int32_t sweep,
+           std::int32_t thickness = 1) const {
+    if (list_ != nullptr) {
+      list_->arc(box, start, sweep, thickness);
+      return;
+    }
+    AngleRange range(start, sweep);
+    if (range.empty() || !box.intersects(clip_)) {
+      return;
+    }
+    if (thickness <= 1) {
+      _rounded(box, box.size, false, &range, nullptr);
+    } else {
+      _thick_arc(box, thickness, range);
+    }
+  }
+
+  /**
+   * @brief 圆角矩形边框，radius 不超过短边的一半
+   */
+  void rounded_frame(const Rect& rect, std::int32_t radius) const {
+    if (list_ != nullptr) {
+      list_->rounded_frame(rect, radius);
+      return;
+    }
+    auto corner = _corner(rect, radius);
+    if (corner.x == 0) {
+      frame(rect);
+    } else if (rect.intersects(clip_)) {
+      _rounded(rect, corner, false, nullptr, nullptr);
+    }
+  }
+
+  /**
+   * @brief 填充圆角矩形，上下圆角逐行输出水平区间，中间按页填充
+   */
+  void rounded_fill(const Rect& rect, std::int32_t radius) const {
+    if (list_ != nullptr) {
+      list_->rounded_fill(rect, radius);
+      return;
+    }
+    auto corner = _corner(rect, radius);
+    if (corner.x == 0) {
+      fill(rect);
+    } else if (rect.intersects(clip_)) {
+      _rounded(rect, corner, true, nullptr, nullptr);
+    }
+  }
+
+  void rounded_fill(const Rect& rect, std::int32_t radius,
+                    const Pattern& pattern) const {
+    if (list_ != nullptr) {
+      list_->rounded_fill(rect, radius, pattern);
+      return;
+    }
+    auto tile = _pattern(pattern);
+    auto corner = _corner(rect, radius);
+    if (corner.x == 0) {
+      _fill(rect, &tile);
+    } else if (rect.intersects(clip_)) {
+      _rounded(rect, corner, true, nullptr, &tile);
+    }
+  }
+
+  /**
+   * @brief 填充多边形，顶点为像素的角点：
+   *        {0, 0}, {4, 0}, {4, 4}, {0, 4} 与 fill({{0, 0}, {4, 4}}) 相同。
+   *        只扫描裁剪区域内的行，每页的各行合并写入
+   *
+   * @param points 顶点，首尾自动相连，超过 MAX_POLYGON_VERTICES 个时不绘制
+   * @param rule 填充规则
+   */
+  void polygon(std::span<const Vec> points,
+               FillRule rule = FillRule::NonZero) const {
+    if (list_ != nullptr) {
+      list_->polygon(points, rule);
+      return;
+    }
+    if (points.size() > MAX_POLYGON_VERTICES) {
+      return;
+    }
+    std::array<Vec, MAX_POLYGON_VERTICES> fixed{};
+    for (std::size_t i = 0; i < points.size(); i++) {
+      fixed[i] = points[i] * (1 << POLYGON_SHIFT);
+    }
+    _polygon({fixed.data(), points.size()}, rule, nullptr);
+  }
+
+  void polygon(std::span<const Vec> points, FillRule rule,
+               const Pattern& pattern) const {
+    if (list_ != nullptr) {
+      list_->polygon(points, rule, pattern);
+      return;
+    }
+    if (points.size() > MAX_POLYGON_VERTICES) {
+      return;
+    }
+    std::array<Vec, MAX_POLYGON_VERTICES> fixed{};
+    for (std::size_t i = 0; i < points.size(); i++) {
+      fixed[i] = points[i] * (1 << POLYGON_SHIFT);
+    }
+    auto tile = _pattern(pattern);
+    _polygon({fixed.data(), points.size()}, rule, &tile);
+  }
+
+  /**
+   * @brief 宽度为 width 的线段，两端各延长宽度的一半（方头），
+   *        按四边形扫描填充；width 不大于 1 时与 line 相同
+   */
+  void stroke(const Geometry::Line<std::int32_t>& segment,
+              std::int32_t width) const {
+    if (list_ != nullptr) {
+      list_->stroke(segment, width);
+      return;
+    }
+    if (width <= 1) {
+      line(segment);
+      return;
+    }
+    auto outline = stroke_outline(segment.start, segment.end, width);
+    _polygon(outline, FillRule::NonZero, nullptr);
+  }
+
+  /**
+   * @brief 绘制位图，at 为位图左上角
+   *        纵向未按页对齐时，每列每页由相邻两页的源字节移位后合成
+   *
+   * @param bitmap 位图
+   * @param at 位图左上角
+   * @param op 光栅操作，默认与 Buffer::mixin 相同为 OR
+   */
+  void blit(const Bitmap& bitmap, Vec at, RasterOp op = RasterOp::Or) const {
+    if (list_ != nullptr) {
+      list_->blit(bitmap, at, op);
+      return;
+    }
+    if (_rotated()) {
+      _rotated_blit(bitmap, nullptr, at, op);
+      return;
+    }
+    _blit(bitmap, nullptr, at, op);
+  }
+
+  /**
+   * @brief 带透明度绘制位图，mask 为 1 的像素取位图的值，为 0 的像素保持不变
+   *
+   * @param bitmap 位图
+   * @param mask 透明度掩码，尺寸与位图相同
+   * @param at 位图左上角
+   */
+  void blit(const Bitmap& bitmap, const Bitmap& mask, Vec at) const {
+    if (mask.width != bitmap.width || mask.pages != bitmap.pages) {
+      return;
+    }
+    if (list_ != nullptr) {
+      list_->blit(bitmap, mask, at);
+      return;
+    }
+    if (_rotated()) {
+      _rotated_blit(bitmap, mask.data, at, RasterOp::Set);
+      return;
+    }
+    _blit(bitmap, mask.data, at, RasterOp::Set);
+  }
+
+  /**
+   * @brief 绘制压缩位图，边解码边合成到表面上，不需要解压缓冲
+   *        裁剪区域以上的页与左右两侧的列直接跳过，最后一页之后不再解码；
+   *        整页对齐的 Set 与 Or 直接按片段复制或填充
+   *
+   * @param bitmap 压缩位图，数据损坏时在出错处停止
+   * @param at 位图左上角
+   * @param op 光栅操作
+   */
+  void blit(const PackedBitmap& bitmap, Vec at,
+            RasterOp op = RasterOp::Or) const {
+    if (list_ != nullptr) {
+      list_->blit(bitmap, at, op);
+      return;
+    }
+    auto area = Rect(at, {bitmap.width, bitmap.height()}).intersection(clip_);
+    if (area.empty() || bitmap.empty()) {
+      return;
+    }
+    if (_rotated()) {
+      _rotated_blit(bitmap, area, at, op);
+      return;
+    }
+
+    auto top = at.y - origin_.y;
+    auto shift = ((top % 8) + 8) % 8;
+    auto base = (top - shift) / 8;
+
+    auto x0 = area.origin.x - origin_.x;
+    auto count = area.size.x;
+    auto sx0 = area.origin.x - at.x;
+    auto y0 = area.origin.y - origin_.y;
+    auto y1 = y0 + area.size.y;
+
+    // 与裁剪区域相交的源页 [first, last)
+    auto first = (y0 - top) / 8;
+    auto last = (y1 - 1 - top) / 8 + 1;
+    auto width = static_cast<std::size_t>(bitmap.width);
+
+    PackBitsReader reader(bitmap.data, bitmap.size);
+    if (!reader.skip(static_cast<std::size_t>(first) * width)) {
+      return;
+    }
+    for (auto page = first; page < last; page++) {
+      // 源页落在表面第 base + page 页的高位与下一页的低位
+      auto lo = base + page;
+      auto keep_lo =
+          static_cast<std::uint8_t>(_rows(lo, y0, y1) & (0xFFU << shift));
+      auto keep_hi = static_cast<std::uint8_t>(_rows(lo + 1, y0, y1) &
+                                               ((1U << shift) - 1));
+      auto* row_lo = keep_lo != 0 ? data_ + lo * width_ + x0 : nullptr;
+      auto* row_hi = keep_hi != 0 ? data_ + (lo + 1) * width_ + x0 : nullptr;
+
+      auto direct = shift == 0 && keep_lo == 0xFF &&
+                    (op == RasterOp::Set || op == RasterOp::Or);
+      auto ok =
+          reader.skip(static_cast<std::size_t>(sx0)) &&
+          reader.read(static_cast<std::size_t>(count),
+                      [&](std::size_t offset, const std::uint8_t* bytes,
+                          std::uint8_t value, std::size_t n) {
+                        if (direct) {
+                          _direct(row_lo + offset, bytes, value, n, op);
+                          return;
+                        }
+                        if (row_lo != nullptr) {
+                          _scatter(row_lo + offset, bytes, value, n, shift,
+                                   keep_lo, op);
+                        }
+                        if (row_hi != nullptr) {
+                          _scatter(row_hi + offset, bytes, value, n,
+                                   shift - 8, keep_hi, op);
+                        }
+                      });
+      auto rest = width - static_cast<std::size_t>(sx0 + count);
+      if (!ok || (page + 1 < last && !reader.skip(rest))) {
+        return;
+      }
+    }
+  }
+
+ private:
+  static constexpr std::uint8_t _apply(std::uint8_t dst, std::uint8_t src,
+                                       std::uint8_t mask, RasterOp op) {
+    src &= mask;
+    switch (op) {
+      case RasterOp::Or:
+        return dst | src;
+      case RasterOp::Set:
+        return static_cast<std::uint8_t>((dst & ~mask) | src);
+      case RasterOp::AndNot:
+        return static_cast<std::uint8_t>(dst & ~src);
+      case RasterOp::Xor:
+        return dst ^ src;
+    }
+    return dst;
+  }
+
+  /**
+   * @brief 旋转表面上绘制位图的一个 8x8 块
+   *        块转置后成为存储中的 8 列，每列一个字节，再按页合成
+   *
+   * @param storage 以存储坐标查看的表面（_storage）
+   * @param columns 块内源位图的列，count 列之后的部分视为透明
+   * @param mask 块内掩码的列，可以为空
+   * @param at 块左上角，逻辑坐标
+   */
+  void _rotated_block(const Surface& storage, const std::uint8_t* columns,
+                      const std::uint8_t* mask, std::int32_t count, Vec at,
+                      RasterOp op) const {
+    auto load = [this, count](const std::uint8_t* bytes) {
+      std::uint64_t block = 0;
+      for (std::int32_t j = 0; j < count; j++) {
+        // 270 度时源列自下而上排列，先翻转列的顺序
+        auto k = rotation_ == Rotation::Clockwise90 ? j : 7 - j;
+        block |= static_cast<std::uint64_t>(bytes[j]) << (k * 8);
+      }
+      return transpose8x8(block);
+    };
+    // 转置后第 i 个字节为源块第 i 行；90 度时第 i 行落在存储的第 7 - i 列
+    auto store = [this](std::uint64_t block, std::uint8_t* out) {
+      for (std::int32_t i = 0; i < 8; i++) {
+        auto k = rotation_ == Rotation::Clockwise90 ? 7 - i : i;
+        out[i] = static_cast<std::uint8_t>(block >> (k * 8));
+      }
+    };
+
+    std::uint8_t image[8];
+    std::uint8_t alpha[8];
+    store(load(columns), image);
+    if (mask != nullptr) {
+      store(load(mask), alpha);
+    }
+    auto block = _map(Rect(at, {8, 8}));
+    const auto* bits = mask != nullptr ? alpha : nullptr;
+    if (count < 8) {
+      // 不足 8 列时块的其余部分不属于位图，Set 不能覆盖
+      storage.clipped(_map(Rect(at, {count, 8})))
+          ._blit(Bitmap{image, 8, 1}, bits, block.origin, op);
+    } else {
+      storage._blit(Bitmap{image, 8, 1}, bits, block.origin, op);
+    }
+  }
+
+  /**
+   * @brief 旋转表面上的位图，只处理与裁剪区域相交的块
+   */
+  void _rotated_blit(const Bitmap& bitmap, const std::uint8_t* mask, Vec at,
+                     RasterOp op) const {
+    auto area = Rect(at, {bitmap.width, bitmap.height()}).intersection(clip_);
+    if (area.empty() || bitmap.empty()) {
+      return;
+    }
+    auto first_page = (area.origin.y - at.y) / 8;
+    auto last_page = (area.origin.y + area.size.y - 1 - at.y) / 8;
+    auto first_block = (area.origin.x - at.x) / 8;
+    auto last_block = (area.origin.x + area.size.x - 1 - at.x) / 8;
+    auto storage = _storage();
+    for (auto page = first_page; page <= last_page; page++) {
+      for (auto block = first_block; block <= last_block; block++) {
+        auto offset = page * bitmap.width + block * 8;
+        auto count = bitmap.width - block * 8 < 8 ? bitmap.width - block * 8
+                                                  : 8;
+        _rotated_block(storage, bitmap.data + offset,
+                       mask != nullptr ? mask + offset : nullptr, count,
+                       {at.x + block * 8, at.y + page * 8}, op);
+      }
+    }
+  }
+
+  /**
+   * @brief 旋转表面上的压缩位图，每次解码一个块
+   *
+   * @param area 位图与裁剪区域的交集
+   */
+  void _rotated_blit(const PackedBitmap& bitmap, const Rect& area, Vec at,
+                     RasterOp op) const {
+    auto first_page = (area.origin.y - at.y) / 8;
+    auto last_page = (area.origin.y + area.size.y - 1 - at.y) / 8;
+    auto first_block = (area.origin.x - at.x) / 8;
+    auto last_block = (area.origin.x + area.size.x - 1 - at.x) / 8;
+    auto width = static_cast<std::size_t>(bitmap.width);
+    auto begin = static_cast<std::size_t>(first_block) * 8;
+    auto end = static_cast<std::size_t>(last_block) * 8 + 8 < width
+                   ? static_cast<std::size_t>(last_block) * 8 + 8
+                   : width;
+
+    PackBitsReader reader(bitmap.data, bitmap.size);
+    if (!reader.skip(static_cast<std::size_t>(first_page) * width)) {
+      return;
+    }
+    std::uint8_t columns[8];
+    auto storage = _storage();
+    for (auto page = first_page; page <= last_page; page++) {
+      if (!reader.skip(begin)) {
+        return;
+      }
+      for (auto x = begin; x < end; x += 8) {
+        auto count = end - x < 8 ? end - x : 8;
+        if (!reader.read({columns, count})) {
+          return;
+        }
+        _rotated_block(storage, columns, nullptr,
+                       static_cast<std::int32_t>(count),
+                       {at.x + static_cast<std::int32_t>(x), at.y + page * 8},
+                       op);
+      }
+      if (page < last_page && !reader.skip(width - end)) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief 表面第 page 页中落在 [y0, y1) 内的行
+   */
+  static std::uint8_t _rows(std::int32_t page, std::int32_t y0,
+                            std::int32_t y1) {
+    auto from = y0 > page * 8 ? y0 - page * 8 : 0;
+    auto to = y1 < (page + 1) * 8 ? y1 - page * 8 : 8;
+    return from < to ? page_mask(from, to) : std::uint8_t{0};
+  }
+
+  /**
+   * @brief 整页对齐时的一个解码片段，原样片段直接复制，重复值直接填充
+   */
+  static void _direct(std::uint8_t* dst, const std::uint8_t* bytes,
+                      std::uint8_t value, std::size_t n, RasterOp op) {
+    if (bytes != nullptr) {
+      _combine(dst, bytes, static_cast<std::int32_t>(n), op);
+    } else if (op == RasterOp::Set) {
+      std::memset(dst, value, n);
+    } else if (value != 0) {
+      for (std::size_t i = 0; i < n; i++) {
+        dst[i] |= value;
+      }
+    }
+  }
+
+  /**
+   * @brief 一个解码片段移位后合成到表面的一页，shift 为负数时右移
+   */
+  template <RasterOp Op>
+  static void _scatter(std::uint8_t* dst, const std::uint8_t* bytes,
+                       std::uint8_t value, std::size_t n, std::int32_t shift,
+                       std::uint8_t keep) {
+    auto move = [shift](std::uint8_t byte) {
+      return static_cast<std::uint8_t>(shift >= 0 ? byte << shift
+                                                  : byte >> -shift);
+    };
+    if (bytes != nullptr) {
+      for (std::size_t i = 0; i < n; i++) {
+        dst[i] = _apply(dst[i], move(bytes[i]), keep, Op);
+      }
+      return;
+    }
+    // 重复值只需要移位一次
+    auto src = move(value);
+    for (std::size_t i = 0; i < n; i++) {
+      dst[i] = _apply(dst[i], src, keep, Op);
+    }
+  }
+
+  static void _scatter(std::uint8_t* dst, const std::uint8_t* bytes,
+                       std::uint8_t value, std::size_t n, std::int32_t shift,
+                       std::uint8_t keep, RasterOp op) {
+    switch (op) {
+      case RasterOp::Or:
+        _scatter<RasterOp::Or>(dst, bytes, value, n, shift, keep);
+        break;
+      case RasterOp::Set:
+        _scatter<RasterOp::Set>(dst, bytes, value, n, shift, keep);
+        break;
+      case RasterOp::AndNot:
+        _scatter<RasterOp::AndNot>(dst, bytes, value, n, shift, keep);
+        break;
+      case RasterOp::Xor:
+        _scatter<RasterOp::Xor>(dst, bytes, value, n, shift, keep);
+        break;
+    }
+  }
+
+  /**
+   * @brief 整页对齐、不需要掩码的一行，按 32 位字处理
+   */
+  static void _combine(std::uint8_t* dst, const std::uint8_t* src,
+                       std::int32_t count, RasterOp op) {
+    auto n = static_cast<std::size_t>(count);
+    if (op == RasterOp::Set) {
+      std::memmove(dst, src, n);
+      return;
+    }
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+      std::uint32_t d = 0;
+      std::uint32_t w = 0;
+      std::memcpy(&d, dst + i, 4);
+      std::memcpy(&w, src + i, 4);
+      if (op == RasterOp::Or) {
+        d |= w;
+      } else if (op == RasterOp::AndNot) {
+        d &= ~w;
+      } else {
+        d ^= w;
+      }
+      std::memcpy(dst + i, &d, 4);
+    }
+    for (; i < n; i++) {
+      dst[i] = _apply(dst[i], src[i], 0xFF, op);
+    }
+  }
+
+  template <RasterOp Op>
+  static void _shifted(std::uint8_t* row, const std::uint8_t* lo,
+                       const std::uint8_t* hi, std::int32_t count,
+                       std::int32_t shift, std::uint8_t keep) {
+    // 源页是否存在在整行内不变，提到循环之外
+    if (lo != nullptr && hi != nullptr) {
+      for (std::int32_t i = 0; i < count; i++) {
+        auto src = static_cast<std::uint8_t>((lo[i] << shift) |
+                                             (hi[i] >> (8 - shift)));
+        row[i] = _apply(row[i], src, keep, Op);
+      }
+    } else if (lo != nullptr) {
+      for (std::int32_t i = 0; i < count; i++) {
+        auto src = static_cast<std::uint8_t>(lo[i] << shift);
+        row[i] = _apply(row[i], src, keep, Op);
+      }
+    } else {
+      for (std::int32_t i = 0; i < count; i++) {
+        auto src = static_cast<std::uint8_t>(hi[i] >> (8 - shift));
+        row[i] = _apply(row[i], src, keep, Op);
+      }
+    }
+  }
+
+  /**
+   * @brief 未对齐页或被裁剪的一行，光栅操作在编译期展开
+   */
+  static void _shifted(std::uint8_t* row, const std::uint8_t* lo,
+                       const std::uint8_t* hi, std::int32_t count,
+                       std::int32_t shift, std::uint8_t keep, RasterOp op) {
+    switch (op) {
+      case RasterOp::Or:
+        _shifted<RasterOp::Or>(row, lo, hi, count, shift, keep);
+        break;
+      case RasterOp::Set:
+        _shifted<RasterOp::Set>(row, lo, hi, count, shift, keep);
+        break;
+      case RasterOp::AndNot:
+        _shifted<RasterOp::AndNot>(row, lo, hi, count, shift, keep);
+        break;
+      case RasterOp::Xor:
+        _shifted<RasterOp::Xor>(row, lo, hi, count, shift, keep);
+        break;
+    }
+  }
+
+  /**
+   * @brief 源位图第 lo 页与第 lo - 1 页移位后合成的一列，不存在的页为 0
+   */
+  static std::uint8_t _gather(const std::uint8_t* lo, const std::uint8_t* hi,
+                              std::int32_t i, std::int32_t shift) {
+    std::uint32_t value = 0;
+    if (lo != nullptr) {
+      value |= static_cast<std::uint32_t>(lo[i]) << shift;
+    }
+    if (hi != nullptr) {
+      value |= static_cast<std::uint32_t>(hi[i]) >> (8 - shift);
+    }
+    return static_cast<std::uint8_t>(value);
+  }
+
+  void _blit(const Bitmap& bitmap, const std::uint8_t* mask, Vec at,
+             RasterOp op) const {
+    auto area = Rect(at, {bitmap.width, bitmap.height()}).intersection(clip_);
+    if (area.empty() || bitmap.empty()) {
+      return;
+    }
+
+    // 位图顶部相对于表面的行，及其所在的页与页内偏移
+    auto top = at.y - origin_.y;
+    auto shift = ((top % 8) + 8) % 8;
+    auto base = (top - shift) / 8;
+
+    auto x0 = area.origin.x - origin_.x;
+    auto count = area.size.x;
+    auto sx0 = area.origin.x - at.x;
+    auto y0 = area.origin.y - origin_.y;
+    auto y1 = y0 + area.size.y;
+
+    for (auto y = y0; y < y1;) {
+      auto page = y >> 3;
+      auto bottom = (page + 1) * 8 < y1 ? (page + 1) * 8 : y1;
+      auto keep = page_mask(y - page * 8, bottom - page * 8);
+      auto* row = data_ + page * width_ + x0;
+
+      // 落在本页的低位部分来自源第 lo 页，高位部分来自第 lo - 1 页
+      auto lo = page - base;
+      auto lo_offset = lo < bitmap.pages ? lo * bitmap.width + sx0 : -1;
+      auto hi_offset = shift != 0 && lo > 0 ? (lo - 1) * bitmap.width + sx0
+                                            : -1;
+      const auto* src_lo = lo_offset < 0 ? nullptr : bitmap.data + lo_offset;
+      const auto* src_hi = hi_offset < 0 ? nullptr : bitmap.data + hi_offset;
+
+      if (mask == nullptr && shift == 0 && keep == 0xFF) {
+        _combine(row, src_lo, count, op);
+      } else if (mask == nullptr) {
+        _shifted(row, src_lo, src_hi, count, shift, keep, op);
+      } else {
+        const auto* mask_lo = lo_offset < 0 ? nullptr : mask + lo_offset;
+        const auto* mask_hi = hi_offset < 0 ? nullptr : mask + hi_offset;
+        for (std::int32_t i = 0; i < count; i++) {
+          auto bits = keep & _gather(mask_lo, mask_hi, i, shift);
+          row[i] = _apply(row[i], _gather(src_lo, src_hi, i, shift),
+                          static_cast<std::uint8_t>(bits), op);
+        }
+      }
+      y = bottom;
+    }
+  }
+
+  static Rect _circle_box(Vec center, std::int32_t radius) {
+    return {{center.x - radius, center.y - radius},
+            {2 * radius + 1, 2 * radius + 1}};
+  }
+
+  /**
+   * @brief 圆角所在椭圆的包围盒大小，不超过矩形
+   */
+  static Vec _corner(const Rect& rect, std::int32_t radius) {
+    auto limit = (rect.size.x < rect.size.y ? rect.size.x : rect.size.y) / 2;
+    radius = radius < limit ? radius : limit;
+    radius = radius > 0 ? radius : 0;
+    return {2 * radius, 2 * radius};
+  }
+
+  /**
+   * @param pattern 以存储坐标平铺的图案，为空时为纯色
+   */
+  void _fill(const Rect& rect, const Pattern* pattern) const {
+    if (_rotated()) {
+      _storage()._fill(_map(rect), pattern);
+      return;
+    }
+    auto area = rect.intersection(clip_);
+    if (area.empty()) {
+      return;
+    }
+    auto x0 = area.origin.x - origin_.x;
+    auto x1 = x0 + area.size.x;
+    auto y0 = area.origin.y - origin_.y;
+    auto y1 = y0 + area.size.y;
+
+    for (auto y = y0; y < y1;) {
+      auto page = y >> 3;
+      auto bottom = (page + 1) * 8 < y1 ? (page + 1) * 8 : y1;
+      auto mask = page_mask(y - page * 8, bottom - page * 8);
+      auto* row = data_ + page * width_;
+      if (pattern == nullptr) {
+        for (auto x = x0; x < x1; x++) {
+          row[x] |= mask;
+        }
+      } else {
+        _tile(row, x0, x1, mask, *pattern);
+      }
+      y = bottom;
+    }
+  }
+
+  /**
+   * @brief 以图案写入一页中的 [x0, x1) 列，中间按 8 列一组写入
+   */
+  static void _tile(std::uint8_t* row, std::int32_t x0, std::int32_t x1,
+                    std::uint8_t mask, const Pattern& pattern) {
+    std::uint8_t bytes[8];
+    for (std::int32_t i = 0; i < 8; i++) {
+      bytes[i] = mask & pattern.columns[i];
+    }
+    auto x = x0;
+    for (; x < x1 && (x & 7) != 0; x++) {
+      row[x] |= bytes[x & 7];
+    }
+    for (; x + 8 <= x1; x += 8) {
+      for (std::int32_t i = 0; i < 8; i++) {
+        row[x + i] |= bytes[i];
+      }
+    }
+    for (; x < x1; x++) {
+      row[x] |= bytes[x & 7];
+    }
+  }
+
+  /**
+   * @brief 以绘制坐标平铺的图案换算为以存储坐标平铺，
+   *        之后第 x % 8 列、第 y % 8 行直接为存储中的列与行
+   */
+  [[nodiscard]] Pattern _pattern(const Pattern& pattern) const {
+    Pattern tile;
+    if (!_rotated()) {
+      auto shift = origin_.y & 7;
+      for (std::int32_t x = 0; x < 8; x++) {
+        std::uint32_t column = pattern.columns[(x + origin_.x) & 7];
+        tile.columns[x] =
+            static_cast<std::uint8_t>(column >> shift | column << (8 - shift));
+      }
+      return tile;
+    }
+    // 旋转后存储的行列为逻辑坐标的列行，逐像素换算一个 8x8 的块
+    for (std::int32_t x = 0; x < 8; x++) {
+      for (std::int32_t y = 0; y < 8; y++) {
+        auto clockwise = rotation_ == Rotation::Clockwise90;
+        auto lx = (clockwise ? y : pages_ * 8 - 1 - y) + origin_.x;
+        auto ly = (clockwise ? width_ - 1 - x : x) + origin_.y;
+        if ((pattern.columns[lx & 7] >> (ly & 7) & 1U) != 0) {
+          tile.columns[x] |= static_cast<std::uint8_t>(1U << y);
+        }
+      }
+    }
+    return tile;
+  }
+
+  /**
+   * @brief 同一页内逐行水平区间的填充
+   *        各行共同覆盖的列合并掩码后每列只写一次，两侧参差的部分逐行写入；
+   *        一行中的第二个区间直接写入。
+   *        旋转的表面直接逐行绘制（存储中为竖直区间，本就按页写入）
+   */
+  class SpanBatch {
+   private:
+    const Surface& surface_;
+
+    /**
+     * @brief 以存储坐标平铺的图案，为空时为纯色
+     */
+    const Pattern* pattern_;
+
+    std::int32_t page_{0};
+    std::uint8_t rows_{0};
+
+    /**
+     * @brief 各行的区间，存储坐标
+     */
+    std::int32_t x0_[8]{};
+    std::int32_t x1_[8]{};
+
+    void _write(std::uint8_t* row, std::int32_t x0, std::int32_t x1,
+                std::uint8_t mask) const {
+      if (pattern_ == nullptr) {
+        for (auto x = x0; x < x1; x++) {
+          row[x] |= mask;
+        }
+      } else {
+        _tile(row, x0, x1, mask, *pattern_);
+      }
+    }
+
+   public:
+    SpanBatch(const Surface& surface, const Pattern* pattern)
+        : surface_(surface), pattern_(pattern) {}
+
+    void add(std::int32_t x0, std::int32_t x1, std::int32_t y) {
+      const auto& clip = surface_.clip_;
+      if (y < clip.origin.y || y >= clip.origin.y + clip.size.y) {
+        return;
+      }
+      if (surface_._rotated()) {
+        surface_._storage()._fill(
+            surface_._map(Rect({x0, y}, {x1 - x0, 1})), pattern_);
+        return;
+      }
+      x0 = x0 > clip.origin.x ? x0 : clip.origin.x;
+      x1 = x1 < clip.origin.x + clip.size.x ? x1 : clip.origin.x + clip.size.x;
+      if (x0 >= x1) {
+        return;
+      }
+      x0 -= surface_.origin_.x;
+      x1 -= surface_.origin_.x;
+      y -= surface_.origin_.y;
+      if (rows_ != 0 && (y >> 3) != page_) {
+        flush();
+      }
+      page_ = y >> 3;
+      auto bit = static_cast<std::uint8_t>(1U << (y & 7));
+      if ((rows_ & bit) != 0) {
+        _write(surface_.data_ + page_ * surface_.width_, x0, x1, bit);
+        return;
+      }
+      rows_ |= bit;
+      x0_[y & 7] = x0;
+      x1_[y & 7] = x1;
+    }
+
+    void flush() {
+      if (rows_ == 0) {
+        return;
+      }
+      // 所有行共同覆盖的列 [left, right)
+      std::int32_t left = INT32_MIN;
+      std::int32_t right = INT32_MAX;
+      for (int i = 0; i < 8; i++) {
+        if ((rows_ >> i & 1U) != 0) {
+          left = x0_[i] > left ? x0_[i] : left;
+          right = x1_[i] < right ? x1_[i] : right;
+        }
+      }
+      auto* row = surface_.data_ + page_ * surface_.width_;
+      for (int i = 0; i < 8; i++) {
+        if ((rows_ >> i & 1U) == 0) {
+          continue;
+        }
+        auto bit = static_cast<std::uint8_t>(1U << i);
+        if (left >= right) {
+          _write(row, x0_[i], x1_[i], bit);
+        } else {
+          _write(row, x0_[i], left, bit);
+          _write(row, right, x1_[i], bit);
+        }
+      }
+      if (left < right) {
+        _write(row, left, right, rows_);
+      }
+      rows_ = 0;
+    }
+  };
+
+  /**
+   * @brief 圆角矩形：四角为内切于 corner 的椭圆的四分之一，
+   *        上下两半分别贴在矩形的顶部与底部；corner 与 rect 大小相同时为椭圆
+   *
+   * @param range 不为空时只画方向在范围内的像素（圆弧）
+   * @param pattern 填充时的图案，以存储坐标平铺，为空时为纯色
+   */
+  void _rounded(const Rect& rect, Vec corner, bool filled,
+                const AngleRange* range, const Pattern* pattern) const {
+    auto [x, y] = rect.origin;
+    auto [width, height] = rect.size;
+    Vec center{2 * x + width, 2 * y + height};
+
+    // 上下两半的行分别由中间向外推进，各自按页合并
+    SpanBatch upper(*this, pattern);
+    SpanBatch lower(*this, pattern);
+    EllipseRows rows(corner.x, corner.y);
+    while (!rows.done()) {
+      auto inset = rows.inset();
+      auto top = y + rows.top();
+      auto bottom = y + rows.bottom() + height - corner.y;
+      rows.next();
+
+      auto x0 = x + inset;
+      auto x1 = x + width - inset;
+      auto i0 = x1;
+      auto i1 = x1;
+      if (!filled && !rows.done()) {
+        // 外侧一行覆盖不到的部分为边框，最外侧一行整行都是
+        auto edge = rows.inset() > inset + 1 ? rows.inset() : inset + 1;
+        i0 = x + edge;
+        i1 = x + width - edge;
+      }
+      if (filled) {
+        upper.add(x0, x1, top);
+        if (bottom != top) {
+          lower.add(x0, x1, bottom);
+        }
+        continue;
+      }
+      _ring(top, x0, x1, i0, i1, range, center);
+      if (bottom != top) {
+        _ring(bottom, x0, x1, i0, i1, range, center);
+      }
+    }
+    upper.flush();
+    lower.flush();
+
+    // 圆角之间的直边
+    auto y0 = y + (corner.y + 1) / 2;
+    auto y1 = y + height - (corner.y + 1) / 2;
+    if (y0 >= y1) {
+      return;
+    }
+    if (filled) {
+      _fill({{x, y0}, {width, y1 - y0}}, pattern);
+    } else {
+      vspan(x, y0, y1);
+      vspan(x + width - 1, y0, y1);
+    }
+  }
+
+  /**
+   * @brief 扫描 24.8 定点顶点的多边形
+   */
+  void _polygon(std::span<const Vec> points, FillRule rule,
+                const Pattern* pattern) const {
+    SpanBatch batch(*this, pattern);
+    scan_polygon(points, rule, clip_.origin.y, clip_.origin.y + clip_.size.y,
+                 [&batch](std::int32_t x0, std::int32_t x1, std::int32_t y) {
+                   batch.add(x0, x1, y);
+                 });
+    batch.flush();
+  }
+
+  /**
+   * @brief 两个同心椭圆之间的环形弧，内外两个椭圆的行一一对应
+   */
+  void _thick_arc(const Rect& box, std::int32_t thickness,
+                  const AngleRange& range) const {
+    auto [x, y] = box.origin;
+    auto [width, height] = box.size;
+    Vec center{2 * x + width, 2 * y + height};
+
+    EllipseRows outer(width, height);
+    EllipseRows inner(width - 2 * thickness, height - 2 * thickness);
+    while (!outer.done()) {
+      auto x0 = x + outer.inset();
+      auto x1 = x + width - outer.inset();
+      auto i0 = x1;
+      auto i1 = x1;
+      if (!inner.done()) {
+        // 至少保留两端各一个像素，避免陡峭处断开
+        i0 = x + thickness + inner.inset();
+        i0 = i0 > x0 + 1 ? i0 : x0 + 1;
+        i1 = x + width - thickness - inner.inset();
+        i1 = i1 < x1 - 1 ? i1 : x1 - 1;
+      }
+      auto top = y + outer.top();
+      auto bottom = y + outer.bottom();
+      _ring(top, x0, x1, i0, i1, &range, center);
+      if (bottom != top) {
+        _ring(bottom, x0, x1, i0, i1, &range, center);
+      }
+      outer.next();
+      inner.next();
+    }
+  }
+
+  /**
+   * @brief 第 y 行的 [x0, x1) 去掉中间的 [i0, i1)，i0 >= i1 时为整段
+   *        range 不为空时按像素相对 center（两倍坐标）的方向过滤
+   */
+  void _ring(std::int32_t y, std::int32_t x0, std::int32_t x1,
+             std::int32_t i0, std::int32_t i1, const AngleRange* range,
+             Vec center) const {
+    if (y < clip_.origin.y || y >= clip_.origin.y + clip_.size.y) {
+      return;
+    }
+    if (i0 >= i1) {
+      i0 = x1;
+      i1 = x1;
+    }
+    if (range == nullptr) {
+      hspan(x0, i0, y);
+      if (i1 < x1) {
+        hspan(i1, x1, y);
+      }
+      return;
+    }
+    _ranged_span(y, x0, i0, *range, center);
+    _ranged_span(y, i1, x1, *range, center);
+  }
+
+  void _ranged_span(std::int32_t y, std::int32_t x0, std::int32_t x1,
+                    const AngleRange& range, Vec center) const {
+    auto dy = 2 * y + 1 - center.y;
+    auto start = x0;
+    for (auto x = x0; x < x1; x++) {
+      if (!range.contains(2 * x + 1 - center.x, dy)) {
+        if (start < x) {
+          hspan(start, x, y);
+        }
+        start = x + 1;
+      }
+    }
+    if (start < x1) {
+      hspan(start, x1, y);
+    }
+  }
+
+  template <typename Fn>
+  static void _bresenham(Vec start, Vec end, Fn&& plot) {
+    std::int32_t dx = end.x - start.x;
+    std::int32_t dy = end.y - start.y;
+    std::int32_t x = start.x;
+    std::int32_t y = start.y;
+    std::int32_t x_inc = (dx < 0) ? -1 : 1;
+    std::int32_t y_inc = (dy < 0) ? -1 : 1;
+    dx = (dx < 0) ? -dx : dx;
+    dy = (dy < 0) ? -dy : dy;
+
+    if (dx > dy) {
+      std::int32_t p = 2 * dy - dx;
+      for (std::int32_t i = 0; i <= dx; i++) {
+        plot(x, y);
+        if (p >= 0) {
+          y += y_inc;
+          p -= 2 * dx;
+        }
+        x += x_inc;
+        p += 2 * dy;
+      }
+    } else {
+      std::int32_t p = 2 * dx - dy;
+      for (std::int32_t i = 0; i <= dy; i++) {
+        plot(x, y);
+        if (p >= 0) {
+          x += x_inc;
+          p -= 2 * dy;
+        }
+        y += y_inc;
+        p += 2 * dx;
+      }
+    }
+  }
+};
+
+}  // namespace SSDUI::Graphics
@@ -0,0 +1,212 @@
+#pragma once
+
+/**
+ *  行优先位图与页格式之间的转换
+ *
+ *  大多数图片格式与主机工具按行存放像素（每个字节为一行中水平的 8 个像素），
+ *  而 Surface 与 Buffer 为页格式（每个字节为一列中竖直的 8 个像素）。
+ *  两者按 8x8 的块互为转置：把块装入一个 64 位字，用三轮移位交换完成转置，
+ *  每块只需要 8 次读取、8 次写入与十几条整数指令，不逐像素搬运。
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ssdui/common/span.hh"
+
+namespace SSDUI::Graphics {
+
+/**
+ * @brief 行优先位图中像素在字节内的顺序
+ */
+enum class BitOrder : std::uint8_t {
+  /**
+   * @brief 最高位为最左侧的像素（PBM、PNG 等）
+   */
+  MsbFirst,
+  /**
+   * @brief 最低位为最左侧的像素（XBM 等）
+   */
+  LsbFirst,
+};
+
+/**
+ * @brief 转置 8x8 位矩阵：第 i 个字节的第 j 位与第 j 个字节的第 i 位交换
+ */
+constexpr std::uint64_t transpose8x8(std::uint64_t x) {
+  std::uint64_t t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+  x ^= t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+  x ^= t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+  x ^= t ^ (t << 28);
+  return x;
+}
+
+namespace Detail {
+
+/**
+ * @brief 转置后第 k 个字节为行字节中的第 k 位，对应的列
+ */
+template <BitOrder Order>
+constexpr std::size_t column_byte(std::size_t k) {
+  return Order == BitOrder::MsbFirst ? 7 - k : k;
+}
+
+template <BitOrder Order>
+void rows_to_pages(const std::uint8_t* rows, std::size_t stride,
+                   std::size_t width, std::size_t height, std::uint8_t* pages,
+                   std::size_t page_stride) {
+  for (std::size_t page = 0; page * 8 < height; page++) {
+    auto lines = height - page * 8 < 8 ? height - page * 8 : 8;
+    const auto* src = rows + page * 8 * stride;
+    auto* dst = pages + page * page_stride;
+    for (std::size_t x = 0; x < width; x += 8) {
+      std::uint64_t block = 0;
+      if (lines == 8) {
+        // 完整的块展开为常数次读取
+        for (std::size_t i = 0; i < 8; i++) {
+          block |= static_cast<std::uint64_t>(src[i * stride + x / 8])
+                   << (i * 8);
+        }
+      } else {
+        for (std::size_t i = 0; i < lines; i++) {
+          block |= static_cast<std::uint64_t>(src[i * stride + x / 8])
+                   << (i * 8);
+        }
+      }
+      block = transpose8x8(block);
+      if (width - x >= 8) {
+        for (std::size_t j = 0; j < 8; j++) {
+          dst[x + j] =
+              static_cast<std::uint8_t>(block >> (column_byte<Order>(j) * 8));
+        }
+      } else {
+        for (std::size_t j = 0; j < width - x; j++) {
+          dst[x + j] =
+              static_cast<std::uint8_t>(block >> (column_byte<Order>(j) * 8));
+        }
+      }
+    }
+  }
+}
+
+template <BitOrder Order>
+void pages_to_rows(const std::uint8_t* pages, std::size_t page_stride,
+                   std::size_t width, std::size_t height, std::uint8_t* rows,
+                   std::size_t stride) {
+  for (std::size_t page = 0; page * 8 < height; page++) {
+    auto lines = height - page * 8 < 8 ? height - page * 8 : 8;
+    const auto* src = pages + page * page_stride;
+    auto* dst = rows + page * 8 * stride;
+    for (std::size_t x = 0; x < width; x += 8) {
+      std::uint64_t block = 0;
+      if (width - x >= 8) {
+        for (std::size_t j = 0; j < 8; j++) {
+          block |= static_cast<std::uint64_t>(src[x + j])
+                   << (column_byte<Order>(j) * 8);
+        }
+      } else {
+        // 超出宽度的列为 0
+        for (std::size_t j = 0; j < width - x; j++) {
+          block |= static_cast<std::uint64_t>(src[x + j])
+                   << (column_byte<Order>(j) * 8);
+        }
+      }
+      block = transpose8x8(block);
+      if (lines == 8) {
+        for (std::size_t i = 0; i < 8; i++) {
+          dst[i * stride + x / 8] = static_cast<std::uint8_t>(block >> (i * 8));
+        }
+      } else {
+        for (std::size_t i = 0; i < lines; i++) {
+          dst[i * stride + x / 8] = static_cast<std::uint8_t>(block >> (i * 8));
+        }
+      }
+    }
+  }
+}
+
+}  // namespace Detail
+
+/**
+ * @brief 行优先位图转换为页格式
+ *        最后一页超出 height 的行填 0
+ *
+ * @param rows 行优先位图，第 y 行从 rows[y * stride] 开始
+ * @param stride 每行的字节数，不小于 (width + 7) / 8
+ * @param width 宽度（像素）
+ * @param height 高度（像素）
+ * @param pages 页格式输出，第 page 页第 x 列为 pages[x + page * page_stride]
+ * @param page_stride 每页的字节数，不小于 width
+ * @param order 行优先位图中像素的顺序
+ * @return bool 缓冲区不够大时不转换并返回 false
+ */
+inline bool rows_to_pages(std::span<const std::uint8_t> rows,
+                          std::size_t stride, std::int32_t width,
+                          std::int32_t height, std::span<std::uint8_t> pages,
+                          std::size_t page_stride,
+                          BitOrder order = BitOrder::MsbFirst) {
+  if (width <= 0 || height <= 0) {
+    return true;
+  }
+  auto w = static_cast<std::size_t>(width);
+  auto h = static_cast<std::size_t>(height);
+  auto page_count = (h + 7) / 8;
+  if (stride < (w + 7) / 8 || page_stride < w ||
+      rows.size() < (h - 1) * stride + (w + 7) / 8 ||
+      pages.size() < (page_count - 1) * page_stride + w) {
+    return false;
+  }
+
+  if (order == BitOrder::MsbFirst) {
+    Detail::rows_to_pages<BitOrder::MsbFirst>(rows.data(), stride, w, h,
+                                              pages.data(), page_stride);
+  } else {
+    Detail::rows_to_pages<BitOrder::LsbFirst>(rows.data(), stride, w, h,
+                                              pages.data(), page_stride);
+  }
+  return true;
+}
+
+/**
+ * @brief 页格式转换为行优先位图，用于截图或发送给主机
+ *        每行超出 width 的填充位为 0
+ *
+ * @param pages 页格式位图，第 page 页第 x 列为 pages[x + page * page_stride]
+ * @param page_stride 每页的字节数，不小于 width
+ * @param width 宽度（像素）
+ * @param height 高度（像素）
+ * @param rows 行优先输出，第 y 行从 rows[y * stride] 开始
+ * @param stride 每行的字节数，不小于 (width + 7) / 8
+ * @param order 行优先位图中像素的顺序
+ * @return bool 缓冲区不够大时不转换并返回 false
+ */
+inline bool pages_to_rows(std::span<const std::uint8_t> pages,
+                          std::size_t page_stride, std::int32_t width,
+                          std::int32_t height, std::span<std::uint8_t> rows,
+                          std::size_t stride,
+                          BitOrder order = BitOrder::MsbFirst) {
+  if (width <= 0 || height <= 0) {
+    return true;
+  }
+  auto w = static_cast<std::size_t>(width);
+  auto h = static_cast<std::size_t>(height);
+  auto page_count = (h + 7) / 8;
+  if (stride < (w + 7) / 8 || page_stride < w ||
+      rows.size() < (h - 1) * stride + (w + 7) / 8 ||
+      pages.size() < (page_count - 1) * page_stride + w) {
+    return false;
+  }
+
+  if (order == BitOrder::MsbFirst) {
+    Detail::pages_to_rows<BitOrder::MsbFirst>(pages.data(), page_stride, w, h,
+                                              rows.data(), stride);
+  } else {
+    Detail::pages_to_rows<BitOrder::LsbFirst>(pages.data(), page_stride, w, h,
+                                              rows.data(), stride);
+  }
+  return true;
+}
+
+}  // namespace SSDUI::Graphics
@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ *  UTF-8 解码
+ *
+ *  逐个码位解码，不分配内存。非法的序列（截断、超长编码、代理区、
+ *  超出 U+10FFFF）按一个字节解码为 U+FFFD，之后从下一个字节继续。
+ */
+
+#include <cstdint>
+#include <string_view>
+
+namespace SSDUI::Graphics {
+
+inline constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+/**
+ * @brief 解码 text 开头的一个码位，并把它从 text 中移除
+ *
+ * @param text 非空的 UTF-8 文本
+ * @return char32_t 码位
+ */
+constexpr char32_t next_codepoint(std::string_view& text) {
+  auto byte = [&](std::size_t index) {
+    return static_cast<std::uint8_t>(text[index]);
+  };
+  auto lead = byte(0);
+
+  std::size_t length = 0;
+  char32_t codepoint = 0;
+  char32_t minimum = 0;
+  if (lead < 0x80) {
+    text.remove_prefix(1);
+    return lead;
+  }
+  if ((lead & 0xE0U) == 0xC0U) {
+    length = 2;
+    codepoint = lead & 0x1FU;
+    minimum = 0x80;
+  } else if ((lead & 0xF0U) == 0xE0U) {
+    length = 3;
+    codepoint = lead & 0x0FU;
+    minimum = 0x800;
+  } else if ((lead & 0xF8U) == 0xF0U) {
+    length = 4;
+    codepoint = lead & 0x07U;
+    minimum = 0x10000;
+  } else {
+    text.remove_prefix(1);
+    return REPLACEMENT_CHARACTER;
+  }
+
+  if (text.size() < length) {
+    text.remove_prefix(1);
+    return REPLACEMENT_CHARACTER;
+  }
+  for (std::size_t i = 1; i < length; i++) {
+    if ((byte(i) & 0xC0U) != 0x80U) {
+      text.remove_prefix(1);
+      return REPLACEMENT_CHARACTER;
+    }
+    codepoint = (codepoint << 6U) | (byte(i) & 0x3FU);
+  }
+  if (codepoint < minimum || codepoint > 0x10FFFF ||
+      (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+    text.remove_prefix(1);
+    return REPLACEMENT_CHARACTER;
+  }
+  text.remove_prefix(length);
+  return codepoint;
+}
+
+}  // namespace SSDUI::Graphics
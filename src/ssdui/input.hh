@@ -0,0 +1,5 @@
+#pragma once
+
+#include "ssdui/input/button.hh"
+#include "ssdui/input/manager.hh"
+#include "ssdui/input/ring.hh"
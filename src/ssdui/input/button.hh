@@ -0,0 +1,133 @@
+#pragma once
+
+/**
+ *  按键识别
+ *
+ *  输入源只负责上报带时间戳的原始电平变化，
+ *  去抖、单击、长按的识别全部在消费者一侧完成。
+ */
+
+#include <chrono>
+#include <cstdint>
+
+#include "ssdui/context/clock.hh"
+
+namespace SSDUI::Input {
+
+using Context::Clock;
+using Context::TimePoint;
+
+/**
+ * @brief 原始输入事件，由输入源（通常是中断）产生
+ */
+struct RawEvent {
+  std::uint8_t channel{0};
+  bool pressed{false};
+  TimePoint timestamp{};
+};
+
+/**
+ * @brief 识别出的按键手势
+ */
+enum class Gesture : std::uint8_t {
+  Press,
+  Release,
+  Click,
+  LongPress,
+};
+
+inline constexpr std::size_t GESTURE_COUNT = 4;
+
+/**
+ * @brief 按键事件数据，随事件一同传递给监听器
+ *        timestamp 为触发该手势的原始电平变化时刻
+ */
+struct InputEvent {
+  std::uint8_t channel{0};
+  Gesture gesture{Gesture::Press};
+  TimePoint timestamp{};
+};
+
+/**
+ * @brief 按键识别参数
+ */
+struct ButtonConfig {
+  static constexpr auto DEFAULT_DEBOUNCE = std::chrono::milliseconds(20);
+  static constexpr auto DEFAULT_CLICK = std::chrono::milliseconds(400);
+  static constexpr auto DEFAULT_LONG_PRESS = std::chrono::milliseconds(800);
+
+  /**
+   * @brief 电平保持超过该时长才视为稳定
+   */
+  Clock::duration debounce{DEFAULT_DEBOUNCE};
+
+  /**
+   * @brief 按下到松开不超过该时长视为单击
+   */
+  Clock::duration click{DEFAULT_CLICK};
+
+  /**
+   * @brief 按下超过该时长视为长按，长按后松开不再产生单击
+   */
+  Clock::duration long_press{DEFAULT_LONG_PRESS};
+};
+
+/**
+ * @brief 单个按键的状态机
+ */
+class Button {
+ private:
+  bool raw_{false};
+  TimePoint raw_since_{};
+
+  bool stable_{false};
+  TimePoint pressed_at_{};
+  bool long_fired_{false};
+
+ public:
+  /**
+   * @brief 输入一次原始电平变化
+   *
+   * @param emit 识别出手势时调用，参数为 (Gesture, TimePoint)
+   */
+  template <typename Emit>
+  void feed(const ButtonConfig& config, bool pressed, TimePoint timestamp,
+            Emit&& emit) {
+    if (pressed == raw_) {
+      return;
+    }
+    // 先结算上一个电平是否已经稳定
+    settle(config, timestamp, emit);
+    raw_ = pressed;
+    raw_since_ = timestamp;
+  }
+
+  /**
+   * @brief 根据当前时间结算稳定电平与长按
+   */
+  template <typename Emit>
+  void settle(const ButtonConfig& config, TimePoint now, Emit&& emit) {
+    if (raw_ != stable_ && now - raw_since_ >= config.debounce) {
+      stable_ = raw_;
+      if (stable_) {
+        pressed_at_ = raw_since_;
+        long_fired_ = false;
+        emit(Gesture::Press, raw_since_);
+      } else {
+        emit(Gesture::Release, raw_since_);
+        if (!long_fired_ && raw_since_ - pressed_at_ <= config.click) {
+          emit(Gesture::Click, raw_since_);
+        }
+      }
+    }
+
+    if (stable_ && !long_fired_ && now - pressed_at_ >= config.long_press) {
+      long_fired_ = true;
+      emit(Gesture::LongPress, pressed_at_ + config.long_press);
+    }
+  }
+
+  [[nodiscard]] bool pressed() const { return stable_; }
+};
+
+}  // namespace SSDUI::Input
@@ -0,0 +1,185 @@
+#pragma once
+
+/**
+ *  输入管理器
+ *
+ *  输入源在中断中调用 push 把原始电平变化写入无锁队列，
+ *  push 与入队放在 IRAM 中，时刻取自 isr_now，不经由 newlib 的时钟；
+ *  管理器在每帧结束时（帧计时器线程）取出并识别手势，
+ *  再按绑定关系转换为平台事件交给事件管理器，事件数据为 InputEvent。
+ *  因此不需要额外的轮询线程，也不会因轮询丢失精确的按键时刻。
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "ssdui/context/clock.hh"
+#include "ssdui/context/context.hh"
+#include "ssdui/input/button.hh"
+#include "ssdui/input/ring.hh"
+#include "ssdui/platform/concepts.hh"
+
+namespace SSDUI::Input {
+
+template <typename Pl, std::size_t Channels = 8, std::size_t Capacity = 32>
+  requires Platform::IsPlatform<Pl>
+class InputManager {
+ public:
+  using Platform = Pl;
+  using Event = typename Platform::Event;
+
+  static constexpr std::size_t CHANNELS = Channels;
+
+ private:
+  Ring<RawEvent, Capacity> ring_{};
+  std::array<Button, Channels> buttons_{};
+  std::array<std::array<std::optional<Event>, GESTURE_COUNT>, Channels>
+      bindings_{};
+  ButtonConfig config_{};
+  SSDUI::Context::Context<Pl>* ctx_{nullptr};
+
+  static void _on_frame(void* data) {
+    auto* self = static_cast<InputManager*>(data);
+    self->poll(self->ctx_);
+    self->ctx_->on_next_frame(&InputManager::_on_frame, self);
+  }
+
+  void _emit(SSDUI::Context::Context<Pl>* ctx, std::uint8_t channel,
+             Gesture gesture, TimePoint timestamp) {
+    auto& event = bindings_[channel][static_cast<std::size_t>(gesture)];
+    if (!event.has_value()) {
+      return;
+    }
+    // poll 在帧回调中执行，识别出的手势仍是外部输入
+    SSDUI::Context::ExternalScope external;
+    ctx->event_manager().trigger_event(*event,
+                                       InputEvent{
+                                           .channel = channel,
+                                           .gesture = gesture,
+                                           .timestamp = timestamp,
+                                       },
+                                       timestamp);
+  }
+
+ public:
+  explicit InputManager(ButtonConfig config = {}) : config_(config) {}
+
+  InputManager(const InputManager&) = delete;
+  InputManager(InputManager&&) = delete;
+  InputManager& operator=(const InputManager&) = delete;
+  InputManager& operator=(InputManager&&) = delete;
+
+  /**
+   * @brief 上报原始电平变化，可在中断上下文调用
+   *
+   * @param channel 通道
+   * @param pressed 是否按下
+   * @param timestamp 电平变化时刻
+   * @return bool 队列已满时返回 false
+   */
+  SSDUI_ISR_ATTR bool push(std::uint8_t channel, bool pressed,
+                           TimePoint timestamp) {
+    if (channel >= Channels) {
+      return false;
+    }
+    return ring_.try_push(RawEvent{
+        .channel = channel,
+        .pressed = pressed,
+        .timestamp = timestamp,
+    });
+  }
+
+  /**
+   * @brief 以当前时刻上报，时间取自 isr_now，可在中断上下文调用
+   */
+  SSDUI_ISR_ATTR bool push(std::uint8_t channel, bool pressed) {
+    return push(channel, pressed, SSDUI::Context::isr_now());
+  }
+
+  /**
+   * @brief 把通道上的手势绑定到平台事件
+   */
+  void bind(std::uint8_t channel, Gesture gesture, Event event) {
+    if (channel < Channels) {
+      bindings_[channel][static_cast<std::size_t>(gesture)] = event;
+    }
+  }
+
+  /**
+   * @brief 取出所有原始事件并识别手势，只允许单个线程调用
+   *
+   * @param ctx 上下文
+   * @param now 当前时间，用于结算去抖与长按
+   */
+  void poll(SSDUI::Context::Context<Pl>* ctx, TimePoint now = Clock::now()) {
+    RawEvent raw{};
+    while (ring_.try_pop(raw)) {
+      buttons_[raw.channel].feed(
+          config_, raw.pressed, raw.timestamp,
+          [this, ctx, &raw](Gesture gesture, TimePoint timestamp) {
+            _emit(ctx, raw.channel, gesture, timestamp);
+          });
+    }
+    for (std::size_t channel = 0; channel < Channels; ++channel) {
+      buttons_[channel].settle(
+          config_, now,
+          [this, ctx, channel](Gesture gesture, TimePoint timestamp) {
+            _emit(ctx, static_cast<std::uint8_t>(channel), gesture,
+                  timestamp);
+          });
+    }
+  }
+
+  /**
+   * @brief 挂载到上下文，此后每帧发送完成后自动调用 poll
+   */
+  void attach(SSDUI::Context::Context<Pl>* ctx) {
+    ctx_ = ctx;
+    ctx->on_next_frame(&InputManager::_on_frame, this);
+  }
+
+  [[nodiscard]] bool pressed(std::uint8_t channel) const {
+    return channel < Channels && buttons_[channel].pressed();
+  }
+
+  /**
+   * @brief 队列满时丢弃的原始事件数
+   */
+  [[nodiscard]] std::uint32_t dropped() const { return ring_.dropped(); }
+
+  ButtonConfig& config() { return config_; }
+};
+
+/**
+ * @brief 主机侧可注入的输入源，用于测试与仿真
+ *        以显式时间戳写入原始事件，配合 poll(ctx, now) 可完全确定地复现输入
+ */
+template <typename Ma>
+class InjectSource {
+ private:
+  Ma* manager_;
+  std::uint8_t channel_;
+
+ public:
+  InjectSource(Ma* manager, std::uint8_t channel)
+      : manager_(manager), channel_(channel) {}
+
+  bool press(TimePoint timestamp) {
+    return manager_->push(channel_, true, timestamp);
+  }
+
+  bool release(TimePoint timestamp) {
+    return manager_->push(channel_, false, timestamp);
+  }
+
+  /**
+   * @brief 在 timestamp 按下并保持 duration 后松开
+   */
+  bool click(TimePoint timestamp, Clock::duration duration) {
+    return press(timestamp) && release(timestamp + duration);
+  }
+};
+
+}  // namespace SSDUI::Input
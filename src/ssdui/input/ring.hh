@@ -0,0 +1,104 @@
+#pragma once
+
+/**
+ *  无锁环形队列
+ *
+ *  有界的多生产者单消费者队列，生产者一侧不加锁、不分配内存，
+ *  可以在中断上下文中调用 try_push。
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "ssdui/context/clock.hh"
+
+namespace SSDUI::Input {
+
+template <typename T, std::size_t N>
+  requires(N >= 2 && (N & (N - 1)) == 0)
+class Ring {
+ public:
+  static constexpr std::size_t CAPACITY = N;
+
+ private:
+  static constexpr std::size_t MASK = N - 1;
+
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  std::array<Cell, N> cells_;
+  std::atomic<std::size_t> head_{0};
+  std::size_t tail_{0};
+
+  /**
+   * @brief 队列满时被丢弃的元素数
+   */
+  std::atomic<std::uint32_t> dropped_{0};
+
+ public:
+  Ring() {
+    for (std::size_t i = 0; i < N; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  Ring(const Ring&) = delete;
+  Ring(Ring&&) = delete;
+  Ring& operator=(const Ring&) = delete;
+  Ring& operator=(Ring&&) = delete;
+
+  /**
+   * @brief 入队，可在中断上下文调用
+   *
+   * @return bool 队列已满时返回 false
+   */
+  SSDUI_ISR_ATTR bool try_push(const T& value) {
+    auto pos = head_.load(std::memory_order_relaxed);
+    while (true) {
+      auto& cell = cells_[pos & MASK];
+      auto seq = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq) -
+                  static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          cell.value = value;
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief 出队，只允许单个消费者调用
+   *
+   * @return bool 队列为空时返回 false
+   */
+  bool try_pop(T& value) {
+    auto& cell = cells_[tail_ & MASK];
+    auto seq = cell.sequence.load(std::memory_order_acquire);
+    if (seq != tail_ + 1) {
+      return false;
+    }
+    value = cell.value;
+    cell.sequence.store(tail_ + N, std::memory_order_release);
+    ++tail_;
+    return true;
+  }
+
+  [[nodiscard]] std::uint32_t dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+};
+
+}  // namespace SSDUI::Input
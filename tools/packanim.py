@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Convert PBM or PNG frames into a delta-encoded SSDUI animation.
+
+Each frame is stored as the byte runs that differ from the previous frame, in
+SSD1306 page format; a final record returns from the last frame to the first
+so the animation can loop. See SSDUI::Graphics::DeltaAnimation in
+src/ssdui/graphics/bitmap.hh for the layout. All frames must have the same
+size. Image options match tools/packimage.py.
+
+Usage:
+    packanim.py spinner.hh frame0.png frame1.png frame2.png
+    packanim.py boot.hh boot/*.pbm --name boot --invert
+"""
+
+import argparse
+import struct
+import sys
+
+from packimage import byte_array, identifier, load, to_pages
+
+# A run header costs 3 bytes, so unchanged gaps shorter than this are cheaper
+# to resend than to split the run around.
+GAP = 4
+MAX_RUN = 255
+
+
+def delta(old, new, width):
+    """Return the record turning page-format frame old into new."""
+    runs = []
+    for start in range(0, len(new), width):
+        end = start + width
+        x = start
+        while x < end:
+            if old[x] == new[x]:
+                x += 1
+                continue
+            first = last = x
+            # extend over changes and short unchanged gaps within this page
+            while x < end and x - first < MAX_RUN:
+                if old[x] != new[x]:
+                    last = x
+                elif x - last >= GAP:
+                    break
+                x += 1
+            runs.append((first, new[first:last + 1]))
+            x = last + 1
+    record = struct.pack("<H", len(runs))
+    for offset, data in runs:
+        record += struct.pack("<HB", offset, len(data)) + data
+    return record
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("output")
+    parser.add_argument("frames", nargs="+")
+    parser.add_argument("--name", default=None,
+                        help="C++ identifier, defaults to the output name")
+    parser.add_argument("--threshold", type=int, default=128,
+                        help="PNG luminance at which a pixel is lit")
+    parser.add_argument("--invert", action="store_true",
+                        help="light dark pixels (PBM: light white pixels)")
+    args = parser.parse_args()
+
+    frames = []
+    size = None
+    for path in args.frames:
+        width, height, rows = load(path, args.threshold, args.invert)
+        if size not in (None, (width, height)):
+            sys.exit(f"{path}: {width}x{height}, expected {size[0]}x{size[1]}")
+        size = (width, height)
+        frames.append(to_pages(width, height, rows))
+    width, height = size
+    pages = frames[0][0]
+    if width * pages > 0x10000:
+        sys.exit("frames larger than 64 KiB are not supported")
+    if len(frames) > 0xFFFF:
+        sys.exit("too many frames")
+
+    images = [data for _, data in frames]
+    blob = delta(bytes(len(images[0])), images[0], width)
+    for old, new in zip(images, images[1:] + images[:1]):
+        blob += delta(old, new, width)
+
+    name = args.name or identifier(args.output)
+    with open(args.output, "w", encoding="utf-8") as out:
+        out.write("#pragma once\n\n")
+        out.write(f"// Generated by tools/packanim.py: {len(images)} frames, "
+                  f"{width}x{height}, {len(images) * len(images[0])} "
+                  f"bytes raw\n\n")
+        out.write("#include <cstdint>\n\n")
+        out.write('#include "ssdui/graphics/bitmap.hh"\n\n')
+        out.write(byte_array(f"{name}_data", blob))
+        out.write(f"inline constexpr SSDUI::Graphics::DeltaAnimation {name}{{\n"
+                  f"    {name}_data, sizeof({name}_data), {width}, {pages}, "
+                  f"{len(images)}}};\n")
+
+    print(f"{len(images)} frames, {width}x{height}, "
+          f"{len(images) * len(images[0])} bytes raw, {len(blob)} bytes delta")
+
+
+if __name__ == "__main__":
+    main()
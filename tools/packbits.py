@@ -0,0 +1,26 @@
+"""PackBits run-length encoding shared by the SSDUI asset tools.
+
+The format matches src/ssdui/graphics/packbits.hh: a header byte n below
+128 is followed by n + 1 literal bytes, and a header byte n of 128 or more
+is followed by one byte repeated n - 125 times (3 to 130).
+"""
+
+
+def packbits(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < 130:
+            run += 1
+        if run >= 3:
+            out += bytes([run + 125, data[i]])
+            i += run
+            continue
+        start = i
+        while i < len(data) and i - start < 128:
+            if i + 2 < len(data) and data[i] == data[i + 1] == data[i + 2]:
+                break
+            i += 1
+        out += bytes([i - start - 1]) + data[start:i]
+    return bytes(out)
@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+"""Convert a PBM or PNG image into a PackBits-compressed SSDUI bitmap.
+
+The output is a C++ header defining the compressed bytes and a
+SSDUI::Graphics::PackedBitmap over them. Pixels are laid out in SSD1306 page
+format (one byte per column per 8-row page, LSB on top), pages first, then
+compressed with the same PackBits scheme as SSDF fonts. Images whose height
+is not a multiple of 8 are padded with unlit rows.
+
+PNG support covers non-interlaced grayscale, RGB, palette and alpha images;
+it needs nothing beyond the standard library. A pixel is lit when its
+luminance is at least --threshold (or below it with --invert); transparent
+pixels are never lit.
+
+Usage:
+    packimage.py splash.png splash.hh
+    packimage.py icons.pbm icons.hh --name icons --invert
+"""
+
+import argparse
+import re
+import struct
+import sys
+import zlib
+
+from packbits import packbits
+
+
+def read_pbm(data):
+    """Return (width, height, rows) where rows[y][x] is 1 for black."""
+    header = re.match(rb"(P[14])(?:\s|#[^\n]*\n)+(\d+)(?:\s|#[^\n]*\n)+"
+                      rb"(\d+)\s", data)
+    if header is None:
+        sys.exit("only P1 and P4 PBM files are supported")
+    magic = header.group(1)
+    width, height = int(header.group(2)), int(header.group(3))
+    body = data[header.end():]
+
+    if magic == b"P1":
+        body = re.sub(rb"#[^\n]*", b"", body)
+        bits = [b - 48 for b in body if b in b"01"]
+        return width, height, [bits[y * width:(y + 1) * width]
+                               for y in range(height)]
+
+    stride = (width + 7) // 8
+    rows = []
+    for y in range(height):
+        line = body[y * stride:(y + 1) * stride]
+        rows.append([line[x // 8] >> (7 - x % 8) & 1 for x in range(width)])
+    return width, height, rows
+
+
+def read_png(data, threshold, invert):
+    """Return (width, height, rows) where rows[y][x] is 1 for lit."""
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        sys.exit("not a PNG file")
+    pos = 8
+    idat = b""
+    palette = []
+    alpha = b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = \
+                struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, length, 3)]
+        elif kind == b"tRNS":
+            alpha = chunk
+        elif kind == b"IDAT":
+            idat += chunk
+        elif kind == b"IEND":
+            break
+    if interlace:
+        sys.exit("interlaced PNG files are not supported")
+    if depth == 16 or (depth != 8 and color not in (0, 3)):
+        sys.exit(f"unsupported PNG depth {depth} for color type {color}")
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    bpp = max(1, channels * depth // 8)
+    stride = (width * channels * depth + 7) // 8
+    raw = zlib.decompress(idat)
+
+    rows = []
+    previous = bytearray(stride)
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = previous[i]
+            c = previous[i - bpp] if i >= bpp else 0
+            if kind == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else b if pb <= pc else c
+                line[i] = (line[i] + pred) & 0xFF
+        previous = line
+
+        pixels = []
+        for x in range(width):
+            if depth < 8:
+                bit = x * depth
+                value = line[bit // 8] >> (8 - depth - bit % 8) \
+                    & ((1 << depth) - 1)
+                sample = (value,)
+            else:
+                sample = tuple(line[x * channels:(x + 1) * channels])
+            pixels.append(sample)
+
+        row = []
+        for sample in pixels:
+            opacity = 255
+            if color == 3:
+                index = sample[0]
+                r, g, b = palette[index]
+                if index < len(alpha):
+                    opacity = alpha[index]
+            elif color == 0:
+                r = g = b = sample[0] * 255 // ((1 << depth) - 1)
+            elif color == 4:
+                r = g = b = sample[0]
+                opacity = sample[1]
+            else:
+                r, g, b = sample[:3]
+                if color == 6:
+                    opacity = sample[3]
+            luminance = (299 * r + 587 * g + 114 * b) // 1000
+            lit = luminance < threshold if invert else luminance >= threshold
+            row.append(1 if lit and opacity >= 128 else 0)
+        rows.append(row)
+    return width, height, rows
+
+
+def load(path, threshold=128, invert=False):
+    """Return (width, height, rows) of a PBM or PNG file, 1 for lit."""
+    with open(path, "rb") as image:
+        data = image.read()
+    if data[:2] in (b"P1", b"P4"):
+        width, height, rows = read_pbm(data)
+        # PBM stores black as 1; by default black pixels are lit
+        if invert:
+            rows = [[1 - v for v in row] for row in rows]
+        return width, height, rows
+    return read_png(data, threshold, invert)
+
+
+def to_pages(width, height, rows):
+    pages = (height + 7) // 8
+    data = bytearray()
+    for page in range(pages):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and rows[y][x]:
+                    byte |= 1 << bit
+            data.append(byte)
+    return pages, bytes(data)
+
+
+def identifier(path):
+    return re.sub(r"\W", "_", path.rsplit("/", 1)[-1].rsplit(".", 1)[0])
+
+
+def byte_array(name, data):
+    lines = [f"  {', '.join(f'0x{b:02X}' for b in data[i:i + 12])},"
+             for i in range(0, len(data), 12)]
+    return (f"inline constexpr std::uint8_t {name}[] = {{\n" +
+            "\n".join(lines) + "\n};\n\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("image")
+    parser.add_argument("output")
+    parser.add_argument("--name", default=None,
+                        help="C++ identifier, defaults to the file name")
+    parser.add_argument("--threshold", type=int, default=128,
+                        help="PNG luminance at which a pixel is lit")
+    parser.add_argument("--invert", action="store_true",
+                        help="light dark pixels (PBM: light white pixels)")
+    args = parser.parse_args()
+
+    width, height, rows = load(args.image, args.threshold, args.invert)
+    pages, raw = to_pages(width, height, rows)
+    packed = packbits(raw)
+
+    name = args.name or identifier(args.image)
+    with open(args.output, "w", encoding="utf-8") as out:
+        out.write("#pragma once\n\n")
+        out.write(f"// Generated by tools/packimage.py from "
+                  f"{args.image.rsplit('/', 1)[-1]}: {width}x{height}, "
+                  f"{len(raw)} bytes raw\n\n")
+        out.write("#include <cstdint>\n\n")
+        out.write('#include "ssdui/graphics/bitmap.hh"\n\n')
+        out.write(byte_array(f"{name}_data", packed))
+        out.write(f"inline constexpr SSDUI::Graphics::PackedBitmap {name}{{\n"
+                  f"    {name}_data, sizeof({name}_data), {width}, {pages}}};\n")
+
+    print(f"{width}x{height}, {len(raw)} bytes raw, "
+          f"{len(packed)} bytes packed")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""Convert a BDF bitmap font into an SSDF font for SSDUI::Graphics::FlashFont.
+
+The output keeps glyphs in SSD1306 page format (one byte per column per
+8-row page, LSB on top). Each glyph is stored PackBits-compressed when that
+is smaller than the raw bytes. See src/ssdui/graphics/flash_font.hh for the
+file layout.
+
+Usage:
+    ssdf.py font.bdf font.ssdf
+    ssdf.py font.bdf font.ssdf --charset strings.txt --ranges 0x20-0x7e
+"""
+
+import argparse
+import struct
+import sys
+
+from packbits import packbits
+
+VERSION = 1
+RAW = 0
+PACKBITS = 1
+
+
+def parse_bdf(path):
+    """Return (ascent, descent, glyphs); glyphs maps codepoint to a dict."""
+    ascent = descent = None
+    bbox = None
+    glyphs = {}
+    glyph = None
+    rows = None
+
+    with open(path, encoding="latin-1") as bdf:
+        for line in bdf:
+            fields = line.split()
+            if not fields:
+                continue
+            key = fields[0]
+            if rows is not None:
+                if key == "ENDCHAR":
+                    glyph["rows"] = rows
+                    if glyph["codepoint"] >= 0:
+                        glyphs[glyph["codepoint"]] = glyph
+                    glyph = rows = None
+                else:
+                    rows.append(int(key, 16))
+            elif key == "FONTBOUNDINGBOX":
+                bbox = [int(v) for v in fields[1:5]]
+            elif key == "FONT_ASCENT":
+                ascent = int(fields[1])
+            elif key == "FONT_DESCENT":
+                descent = int(fields[1])
+            elif key == "STARTCHAR":
+                glyph = {"codepoint": -1, "advance": 0, "bbx": bbox}
+            elif key == "ENCODING":
+                glyph["codepoint"] = int(fields[1])
+            elif key == "DWIDTH":
+                glyph["advance"] = int(fields[1])
+            elif key == "BBX":
+                glyph["bbx"] = [int(v) for v in fields[1:5]]
+            elif key == "BITMAP":
+                rows = []
+
+    if ascent is None or descent is None:
+        if bbox is None:
+            sys.exit(f"{path}: missing FONT_ASCENT/FONT_DESCENT")
+        ascent = bbox[1] + bbox[3]
+        descent = -bbox[3]
+    return ascent, descent, glyphs
+
+
+def rasterize(glyph, ascent, pages):
+    """Return (width, pages, top, left, data) with blank edges trimmed."""
+    width, height, xoff, yoff = glyph["bbx"]
+    row_bits = (width + 7) // 8 * 8
+    top = ascent - (yoff + height)
+
+    pixels = set()
+    for y, row in enumerate(glyph["rows"][:height]):
+        for x in range(width):
+            if row >> (row_bits - 1 - x) & 1:
+                line = top + y
+                if 0 <= line < pages * 8:
+                    pixels.add((x, line))
+    if not pixels:
+        return 0, 0, 0, 0, b""
+
+    x0 = min(x for x, _ in pixels)
+    x1 = max(x for x, _ in pixels) + 1
+    p0 = min(y for _, y in pixels) // 8
+    p1 = max(y for _, y in pixels) // 8 + 1
+
+    data = bytearray()
+    for page in range(p0, p1):
+        for x in range(x0, x1):
+            byte = 0
+            for bit in range(8):
+                if (x, page * 8 + bit) in pixels:
+                    byte |= 1 << bit
+            data.append(byte)
+    return x1 - x0, p1 - p0, p0, xoff + x0, bytes(data)
+
+
+def parse_ranges(text):
+    codepoints = set()
+    for part in filter(None, text.split(",")):
+        lo, _, hi = part.partition("-")
+        codepoints.update(range(int(lo, 0), int(hi or lo, 0) + 1))
+    return codepoints
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("bdf")
+    parser.add_argument("output")
+    parser.add_argument("--charset", action="append", default=[],
+                        help="UTF-8 file whose characters are kept")
+    parser.add_argument("--ranges", default="",
+                        help="codepoint ranges to keep, e.g. 0x20-0x7e")
+    parser.add_argument("--blank", type=int, default=None,
+                        help="advance of characters missing from the font")
+    args = parser.parse_args()
+
+    ascent, descent, glyphs = parse_bdf(args.bdf)
+    pages = (ascent + descent + 7) // 8
+
+    keep = parse_ranges(args.ranges)
+    for path in args.charset:
+        with open(path, encoding="utf-8") as charset:
+            keep.update(ord(c) for c in charset.read() if c not in "\r\n")
+    if keep:
+        glyphs = {cp: g for cp, g in glyphs.items() if cp in keep}
+
+    codepoints = sorted(glyphs)
+    blank = args.blank
+    if blank is None:
+        blank = glyphs[32]["advance"] if 32 in glyphs else pages * 4
+
+    index = bytearray()
+    blob = bytearray()
+    base = 16 + 16 * len(codepoints)
+    raw_total = 0
+    for cp in codepoints:
+        glyph = glyphs[cp]
+        width, gpages, top, left, data = rasterize(glyph, ascent, pages)
+        if width > 255 or not -128 <= left <= 127:
+            sys.exit(f"U+{cp:04X}: glyph too large")
+        packed = packbits(data)
+        encoding, stored = (PACKBITS, packed) if len(packed) < len(data) \
+            else (RAW, data)
+        index += struct.pack("<IIHBBBbBB", cp, base + len(blob), len(stored),
+                             width, gpages, top, left,
+                             min(glyph["advance"], 255), encoding)
+        blob += stored
+        raw_total += len(data)
+
+    header = b"SSDF" + struct.pack("<BBBBII", VERSION, pages, blank, 0,
+                                   len(codepoints), 0)
+    with open(args.output, "wb") as out:
+        out.write(header + index + blob)
+
+    print(f"{len(codepoints)} glyphs, {pages} pages, "
+          f"{raw_total} bytes raw, {len(blob)} bytes stored, "
+          f"{len(header) + len(index) + len(blob)} bytes total")
+
+
+if __name__ == "__main__":
+    main()